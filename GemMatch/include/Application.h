@@ -13,6 +13,8 @@ class BoardModel;
 class BoardView;
 class BoardController;
 class CountdownTimer;
+class TextureAtlas;
+class RenderQueue;
 
 /*! Central Application class
 *	Sets up the whole application and runs the main logic and rendering loop
@@ -34,6 +36,12 @@ public:
 	// returns a pointer to the SDL renderer
 	SDL_Renderer* GetRenderer() const;
 
+	// returns the atlas that holds the images of all small sprites
+	TextureAtlas* GetAtlas() const { return m_Atlas; }
+
+	// returns the queue that collects the draw calls of the current frame
+	RenderQueue* GetRenderQueue() const { return m_RenderQueue; }
+
 	// returns the path where the main font is located
 	std::string GetMainFontPath() const;
 
@@ -44,12 +52,21 @@ private:
 	*/
 	bool Initialize();
 
-	// logic loop
-	void Update();
+	/*! \brief Advances the game logic by one fixed step
+	*
+	*	\param deltaTime The length of the step in seconds
+	*/
+	void Update(const double& deltaTime);
 
 	// render loop
 	void Render();
 
+	/*! \brief Draws the background into the static layer, creates it if necessary
+	*
+	*	\return false if the renderer can not draw into textures
+	*/
+	bool BuildStaticLayer();
+
 	// free all resources
 	void CleanUp();
 
@@ -69,9 +86,24 @@ private:
 	SDL_Surface* m_MainSurface = nullptr;
 	Sprite* m_Background = nullptr;
 
+	// sorts the draw calls of a frame by layer and texture
+	RenderQueue* m_RenderQueue = nullptr;
+
+	// window sized copy of the background, it covers the whole window so no clear is needed
+	SDL_Texture* m_StaticLayer = nullptr;
+
+	// one texture for gems, cursor, highlight and overlay
+	TextureAtlas* m_Atlas = nullptr;
+
 	//target framerate
 	static const uint32_t m_TargetFrameRate = 60;
 
+	// logic steps per second, independent of the frame rate
+	static const uint32_t m_LogicRate = 120;
+
+	// longest time in milliseconds a single frame advances the logic by, so a load spike does not freeze the game catching up
+	static const uint32_t m_MaxFrameTime = 250;
+
 	// inital window dimensions
 	static const uint32_t m_WindowWidth = 755;
 	static const uint32_t m_WindowHeight = 600;
@@ -91,6 +123,11 @@ private:
 	bool m_HasGameStarted;
 	bool m_HasGameFinished;
 
+	// an event may have changed the screen, so the next frame has to be drawn
+	bool m_NeedsRedraw;
+	// presenting a frame waits for the display
+	bool m_HasVSync;
+
 	// start screen
 	Sprite* m_OverlayBackground;
 	Label* m_WelcomeLabel;
@@ -101,9 +138,11 @@ private:
 	Label* m_PlayAgainLabel;
 
 	// members for maintaining target framerate
-	uint32_t m_WaitTime = (uint32_t) 1000.0f / m_TargetFrameRate;
-	uint32_t m_FrameStartTime = 0;
-	int32_t m_DelayTime;
+	uint64_t m_CounterFrequency = 0;
+	uint64_t m_FrameStartCounter = 0;
+
+	// logic time that has passed but has not been simulated yet, in seconds
+	double m_AccumulatedTime = 0.0;
 
 	// file path to the main font
 	static const std::string FONT_PATH;
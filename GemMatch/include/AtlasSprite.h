@@ -0,0 +1,25 @@
+#ifndef __ATLAS_SPRITE_H__
+#define __ATLAS_SPRITE_H__
+
+#include <SDL.h>
+#include <string>
+#include "Sprite.h"
+
+class TextureAtlas;
+
+/*! A sprite that draws its part of a texture atlas.
+*	All atlas sprites share one texture, the render queue applies the tint and transparency of each of them.
+*/
+class AtlasSprite : public Sprite
+{
+public:
+	/*! \brief Creates a sprite for an image of the atlas
+	*
+	*	\param atlas The built atlas, it must outlive the sprite
+	*	\param file The path the image has been added to the atlas with
+	*/
+	AtlasSprite(const TextureAtlas& atlas, const std::string& file);
+	virtual ~AtlasSprite();
+};
+
+#endif
@@ -1,8 +1,12 @@
 #ifndef __BOARD_CONTROLLER_H__
 #define __BOARD_CONTROLLER_H__
 
-class BoardModel;
+#include <vector>
+#include <future>
+#include "BoardModel.h"
+
 class BoardView;
+class IBotPlayer;
 
 /*! Sits in the middle of the BoardModel and the BoardView and manages both.
 *	Sets up the board and handles the game logic.
@@ -18,6 +22,12 @@ public:
 	*/
 	enum class BoardState { Uninitialized, Freeze, Ready, GemsSwapped, GemsSelected, SequenceDetected, SequencesRemoved, GemsDopped };
 
+	/*! \brief How holes get closed after sequences have been removed
+	*
+	*	RowByRow drops gems one row per step, Compact settles the whole board in a single step.
+	*/
+	enum class DropMode { RowByRow, Compact };
+
 	/*! \brief Initialized the board with a fresh set of gems
 	*
 	*/
@@ -30,8 +40,27 @@ public:
 
 	/*! \brief Processes the game logic
 	*
+	*	\param deltaTime The time the logic advances by in seconds
+	*/
+	void Update(const double& deltaTime);
+
+	/*! Selects how holes get closed after sequences have been removed */
+	void SetDropMode(const DropMode& dropMode) { m_DropMode = dropMode; }
+
+	/*! \brief Lets a bot pick the swaps instead of the user
+	*
+	*	The bot searches on a copy of the board in the background while the view keeps rendering.
+	*	The controller takes ownership of the bot, nullptr gives control back to the user.
+	*
+	*	\param botPlayer The bot that plays the board
 	*/
-	void Update();
+	void SetBotPlayer(IBotPlayer* botPlayer);
+
+	/*! Returns true if a bot picks the swaps */
+	bool IsBotEnabled() const { return m_BotPlayer != nullptr; }
+
+	/*! Returns true if the board waits for the user: it is frozen or settled and no bot is playing */
+	bool IsIdle() const;
 
 	/*! Returns a pointer to the board view	*/
 	BoardView* GetView() const { return m_View; }
@@ -43,26 +72,41 @@ private:
 	/*! Detects color sequences in the board */
 	void FindSequences();
 
-	/*! Removes color sequences from the board */
-	void RemoveSequences();
+	/*! Removes color sequences from the board once they have been shown long enough */
+	void RemoveSequences(const double& deltaTime);
 
 	/*! Drops gems one row at a time */
-	void DropGems();
+	void DropGems(const double& deltaTime);
+
+	/*! Replaces all gems of the view with the current colors of the board */
+	void RebuildView();
+
+	/*! Applies the changes of the last model step to the view */
+	void ApplyDeltas();
+
+	/*! Moves the gems of the view according to the movements of a compaction */
+	void ApplyDropMoves();
+
+	/*! Starts a bot search or selects the gems of its swap once the search has finished */
+	void UpdateBot();
+
+	/*! Waits for a running bot search and drops its result */
+	void CancelBotSearch();
 
 	/*! Callback handler that gets invoked when two gems have been selected */
-	void OnGemsSelected(const uint8_t& sourceX, const uint8_t& sourceY, const uint8_t& targetX, const uint8_t& targetY);
+	void OnGemsSelected(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY);
 
-	/*! Callback handler that gets invoked when a new color has been added to the board */
-	void OnColorAdded(const uint8_t& column, const uint8_t& row);
+	/*! Handler that gets invoked when a new color has been added to the board */
+	void OnColorAdded(const uint16_t& column, const uint16_t& row);
 
 	/*! Handler that gets invoked when a color has been removed to the board */
-	void OnColorRemoved(const uint8_t& column, const uint8_t& row);
+	void OnColorRemoved(const uint16_t& column, const uint16_t& row);
 
 	/*! Handler that gets invoked when a color dropped down one row */
-	void OnColorDropped(const uint8_t& column, const uint8_t& row);
+	void OnColorDropped(const uint16_t& column, const uint16_t& row);
 
 	/*! Handler that gets invoked when a color is detected to be part of a sequence */
-	void OnSequenceFound(const uint8_t& column, const uint8_t& row);
+	void OnSequenceFound(const uint16_t& column, const uint16_t& row);
 
 private:
 
@@ -70,20 +114,34 @@ private:
 	BoardModel* m_Board;
 	BoardView* m_View;
 
-	// amount of delay between dropping one row of gems in milliseconds
-	uint32_t m_DropDelay;
-	uint32_t m_DropStartTime;
+	// amount of delay between dropping one row of gems in seconds
+	double m_DropDelay;
+	// logic time since the last row has been dropped
+	double m_DropTime;
 
-	// amount of delay after removing a sequence of gems in milliseconds
-	uint32_t m_RemoveSequenceDelay;
-	uint32_t m_RemoveSequenceStartTime;
+	// how holes get closed
+	DropMode m_DropMode;
+	// movements of the last compaction
+	std::vector<BoardModel::DropMove> m_DropMoves;
 
-	// store selected gems
-	uint8_t m_SelectedSourceCellX;
-	uint8_t m_SelectedSourceCellY;
-	uint8_t m_SelectedTargetCellX;
-	uint8_t m_SelectedTargetCellY;
+	// amount of delay after removing a sequence of gems in seconds
+	double m_RemoveSequenceDelay;
+	// logic time since the sequences have been detected
+	double m_RemoveSequenceTime;
 
+	// store selected gems
+	uint16_t m_SelectedSourceCellX;
+	uint16_t m_SelectedSourceCellY;
+	uint16_t m_SelectedTargetCellX;
+	uint16_t m_SelectedTargetCellY;
+
+	// bot that replaces the user input, if there is one
+	IBotPlayer* m_BotPlayer;
+	// result of the running bot search and the swap it found
+	std::future<bool> m_BotSearch;
+	BoardModel::Move m_BotMove;
+	// hash of the board the running search was started on
+	uint64_t m_BotSearchHash;
 
 };
 
@@ -2,21 +2,38 @@
 #define __BOARDVIEW_H__
 
 #include <functional>
+#include <vector>
+#include <SDL.h>
 #include "IMouseListener.h"
 #include "Gem.h"
 
 class Gem;
 class GemFactory;
+class TextureAtlas;
+class RenderQueue;
 
 /*! Displays the state of the BoardModel to the user and processes user input
-*	
+*	The settled gems are kept in a texture together with the background below them,
+*	only the cells that have changed since the last frame are drawn into it again.
 */
 class BoardView : IMouseListener
 {
 public:
-	BoardView(const uint8_t& columns, const uint8_t& rows);
+	/*! \brief Creates an empty board view
+	*
+	*	\param columns The amount of columns
+	*	\param rows The amount of rows
+	*	\param atlas The atlas that holds the gem, cursor and highlight images, see AddImages()
+	*/
+	BoardView(const uint16_t& columns, const uint16_t& rows, const TextureAtlas& atlas);
 	virtual ~BoardView();
 
+	/*! \brief Adds the images of the gems, the cursor and the highlight to an atlas before it gets built
+	*
+	*	\param atlas The atlas to add the images to
+	*/
+	static void AddImages(TextureAtlas& atlas);
+
 	enum class State { Freeze, SelectFirstGem, SelectSecondGem, RemoveGems };
 
 	/*! \brief Sets the position of the board
@@ -73,13 +90,27 @@ public:
 	*	\param targetColumn Horizontal postion of target cell
 	*	\param targetRow Vertical postion of target cell
 	*/
-	void MoveGem(Gem* gem, const uint8_t& targetColumn, const uint8_t& targetRow);
+	void MoveGem(Gem* gem, const uint16_t& targetColumn, const uint16_t& targetRow);
 
 	/*! \brief Renders the board view
 	*
 	*/
 	void Render();
 
+	/*! \brief Sets the background the board is drawn over
+	*
+	*	The board texture caches the part of it below the cells, without a background all gems are drawn every frame.
+	*
+	*	\param background A texture of the size of the window, drawn at its top left corner
+	*/
+	void SetBackground(SDL_Texture* background);
+
+	/*! Redraws all cells on the next frame, e.g. after the renderer has lost the contents of its target textures */
+	void Invalidate();
+
+	/*! Returns true if cells have changed since the last frame */
+	bool HasChanged() const { return m_IsBoardDirty || m_HasDirtyCells; }
+
 	/*! \brief Enables or disables user input
 	*
 	*	\param isInputEnabled Flag to enable or disable input
@@ -93,7 +124,7 @@ public:
 	const bool IsInputEnabled();
 
 	// registration method for handlers that want to know which gems have been selected
-	void SetGemsSelectedHandler(std::function<void(const uint8_t&, const uint8_t&, const uint8_t&, const uint8_t&)> handlerFunction);
+	void SetGemsSelectedHandler(std::function<void(const uint16_t&, const uint16_t&, const uint16_t&, const uint16_t&)> handlerFunction);
 
 private:
 	// process mouse events
@@ -102,19 +133,37 @@ private:
 	void OnMouseReleased(SDL_Event* in_Event) override;
 	
 	// highlight a cell
-	void HighlightCell(const uint8_t& column, const uint8_t& row);
+	void HighlightCell(const uint16_t& column, const uint16_t& row);
 
 	// resets the state of a gem
-	void ResetCell(const uint8_t& column, const uint8_t& row);
+	void ResetCell(const uint16_t& column, const uint16_t& row);
 
 	void SwapCells(const int& firstCell, const int& secondCell);
 
 	// detects if mouse is within board bounds
 	bool IsMouseOverBoard();
 
+	// marks a cell to be drawn into the board texture again
+	void MarkCellDirty(const uint32_t& cell);
+
+	/*! \brief Draws the dirty cells into the board texture, creates it if necessary
+	*
+	*	\return false if the board can not be cached and has to be drawn every frame
+	*/
+	bool UpdateBoardTexture();
+
+	/*! \brief Submits the gem of a cell, if it is part of the settled board
+	*
+	*	\param queue The queue to submit to
+	*	\param cell The index of the cell
+	*	\param x The horizontal position to draw at
+	*	\param y The vertical position to draw at
+	*/
+	void RenderCell(RenderQueue& queue, const uint32_t& cell, const int& x, const int& y);
+
 	// amount of cells
-	const uint8_t m_Columns;
-	const uint8_t m_Rows;
+	const uint16_t m_Columns;
+	const uint16_t m_Rows;
 
 	// position and dimensions of the board
 	uint32_t m_PosX;
@@ -156,8 +205,24 @@ private:
 	// sprite for highlighting removed gems
 	Sprite* m_RemoveHighlight = nullptr;
 
+	// the window sized background the board is drawn over
+	SDL_Texture* m_Background = nullptr;
+
+	// the settled gems and the background below them
+	SDL_Texture* m_BoardTexture = nullptr;
+	// draws the dirty cells into the board texture
+	RenderQueue* m_BoardQueue = nullptr;
+	// false if the renderer can not draw into textures
+	bool m_IsCachingSupported;
+
+	// cells that have changed since they have been drawn into the board texture
+	std::vector<bool> m_DirtyCells;
+	bool m_HasDirtyCells;
+	// the whole texture has to be drawn again
+	bool m_IsBoardDirty;
+
 	// handler functions
-	std::function <void(const uint8_t&, const uint8_t&, const uint8_t&, const uint8_t&)> GemsSelected;
+	std::function <void(const uint16_t&, const uint16_t&, const uint16_t&, const uint16_t&)> GemsSelected;
 
 	// file paths to sprites
 	static const std::string SELECTION_CURSOR_PATH;
@@ -30,22 +30,36 @@ public:
 	/*! Resets timer to start time	*/
 	void Reset();
 
-	/*! Updates timer logic	*/
-	void Update();
+	/*! \brief Updates timer logic
+	*
+	*	\param deltaTime The time that has passed in seconds
+	*/
+	void Update(const double& deltaTime);
 
 	/*! Renders the countdown label */
 	void Render();
 
+	/*! Returns true if the label has changed or the time is over since the last Render() */
+	bool HasChanged() const { return m_HasChanged; }
+
+	/*! \brief Returns the time until Update() changes something
+	*
+	*	\return The time in milliseconds, rounded up, -1 if the timer is stopped
+	*/
+	int32_t GetTimeUntilNextTick() const;
+
 	/*! Registers a handler that gets called when time is over */
 	void SetFinishedHandler(std::function < void()> handlerFunction);
 
 private:
 	uint32_t m_Time;
 	uint32_t m_StartTime;
-	uint32_t m_StartTicks;
+	// time since the last interval ended in seconds
+	double m_ElapsedTime;
 	uint32_t m_Interval;
 
 	bool m_HasStarted;
+	bool m_HasChanged;
 
 	Label* m_Label;
 	std::function < void()> m_CountdownFinishEvent;
@@ -3,7 +3,9 @@
 
 #include <cstdint>
 #include <string>
+#include "GemColor.h"
 #include "Sprite.h"
+#include "RenderQueue.h"
 
 /*! Holds the visual representation of a color
 *
@@ -12,7 +14,7 @@ class Gem
 {
 public:
 	// gem colors
-	enum class Color { Red, Green, Blue, Purple, Yellow, COUNT, NONE };
+	typedef GemColor Color;
 	enum class State { Normal, Dragged, Highlighted, Removed, Selected };
 
 	Gem(Color color);
@@ -35,7 +37,12 @@ public:
 
 	Sprite* GetSprite() const { return m_Sprite; }
 
-	void Render();
+	/*! \brief Submits the gem's sprite with the tint of its state
+	*
+	*	\param queue The queue to submit to
+	*	\param layer The layer to draw the gem on
+	*/
+	void Render(RenderQueue& queue, const RenderQueue::Layer& layer = RenderQueue::Layer::Board);
 
 	uint8_t m_Alpha;
 
@@ -9,6 +9,7 @@
 
 class Sprite;
 class Gem;
+class TextureAtlas;
 
 /*! Produces and recycles gems.
 *	Implementation of the Flyweight pattern: all gems of the same color share the same sprite.
@@ -17,9 +18,19 @@ class Gem;
 class GemFactory
 {
 public:
-	GemFactory();
+	/*! \brief Creates the sprites of all gem colors
+	*
+	*	\param atlas The atlas that holds the gem images, see AddImages()
+	*/
+	GemFactory(const TextureAtlas& atlas);
 	virtual ~GemFactory();
 
+	/*! \brief Adds the images of all gem colors to an atlas before it gets built
+	*
+	*	\param atlas The atlas to add the images to
+	*/
+	static void AddImages(TextureAtlas& atlas);
+
 	/*! Retrieves a pointer to a gem of the specified color */
 	Gem* GetGem(Gem::Color color);
 
@@ -3,6 +3,7 @@
 
 #include <SDL_ttf.h>
 #include <string>
+#include "RenderQueue.h"
 
 /*! A text label that renders a True Type Font
 *
@@ -22,7 +23,10 @@ public:
 	/*! Sets label color */
 	void SetColor(const uint8_t &r, const uint8_t &g, const uint8_t &b);
 
-	/*! Renders label */
+	/*! Sets the layer the label is drawn on */
+	void SetLayer(const RenderQueue::Layer& layer) { m_Layer = layer; }
+
+	/*! Submits the label to the render queue of the application */
 	void Render();
 
 private:
@@ -36,6 +40,7 @@ private:
 	SDL_Surface *m_Surface = nullptr;
 	SDL_Texture *m_Texture = nullptr;
 	SDL_Rect m_Rect;
+	RenderQueue::Layer m_Layer;
 };
 
 #endif
@@ -0,0 +1,78 @@
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+/*! Collects the draw calls of a frame and issues them at once, sorted by layer and texture.
+*	Tint and transparency belong to each item, so the state of a shared texture
+*	is only changed when an item needs it different from the item drawn before.
+*/
+class RenderQueue
+{
+public:
+	/*! Drawing order, items of a higher layer cover the ones below */
+	enum class Layer : uint8_t { Background, Board, BoardHighlight, Dragged, Interface, Overlay, OverlayText };
+
+	RenderQueue(SDL_Renderer* renderer);
+	virtual ~RenderQueue();
+
+	/*! \brief Adds a draw call to the current frame
+	*
+	*	Items of the same layer and texture are drawn in the order they have been submitted.
+	*
+	*	\param texture The texture to draw from
+	*	\param sourceRect The part of the texture to draw, nullptr draws all of it
+	*	\param destinationRect Where to draw on the screen
+	*	\param color Tint and transparency of the item
+	*	\param layer The layer to draw the item on
+	*/
+	void Submit(SDL_Texture* texture, const SDL_Rect* sourceRect, const SDL_Rect& destinationRect, const SDL_Color& color, const Layer& layer);
+
+	/*! Draws all submitted items and empties the queue */
+	void Flush();
+
+	// returns the amount of color and alpha changes of the last frame
+	uint32_t GetStateChangeCount() const { return m_StateChangeCount; }
+
+private:
+	/*! A single draw call */
+	struct Item
+	{
+		SDL_Texture* texture;
+		SDL_Rect sourceRect;
+		bool hasSourceRect;
+		SDL_Rect destinationRect;
+		SDL_Color color;
+		Layer layer;
+		// submission index, keeps the sort stable
+		uint32_t order;
+	};
+
+	/*! The tint and transparency a texture has been left with */
+	struct TextureState
+	{
+		SDL_Texture* texture;
+		SDL_Color color;
+	};
+
+	/*! \brief Returns the known state of a texture, it is read from SDL the first time a frame uses the texture
+	*
+	*	\param texture The texture
+	*/
+	TextureState& GetTextureState(SDL_Texture* texture);
+
+	SDL_Renderer* m_Renderer = nullptr;
+
+	// draw calls of the current frame
+	std::vector<Item> m_Items;
+
+	// textures drawn in the current frame, only a few, so a linear search is fine
+	std::vector<TextureState> m_TextureStates;
+
+	// amount of color and alpha changes of the last frame
+	uint32_t m_StateChangeCount;
+};
+
+#endif
@@ -3,8 +3,9 @@
 
 #include <SDL.h>
 #include <string>
+#include "RenderQueue.h"
 
-/*! Sets up and draws SDL textures
+/*! Sets up SDL textures and submits them to the render queue
 *
 */
 class Sprite
@@ -15,8 +16,13 @@ public:
 	virtual ~Sprite();
 
 	void Load(const std::string &file);
+
+	/*! Submits the sprite to the render queue of the application */
 	void Render();
 
+	/*! Submits the sprite to another queue, e.g. one that draws into a texture */
+	void Render(RenderQueue& queue);
+
 	/*! Sets sprite position */
 	void SetPosition(const int &x, const int &y);
 
@@ -38,6 +44,9 @@ public:
 	/*! Tints the sprite with the specified color */
 	void SetColor(const uint8_t& red, const uint8_t& green, const uint8_t& blue);
 
+	/*! Sets the layer the sprite is drawn on */
+	void SetLayer(const RenderQueue::Layer& layer) { m_Layer = layer; }
+
 	/*! Retrieves the sprite's width */
 	int GetWidth() const;
 
@@ -47,11 +56,22 @@ public:
 	/*! Retrieves the rectangle that hold the sprite's dimensions */
 	SDL_Rect Sprite::GetRect() const;
 
-private:
+	/*! Retrieves the texture the sprite draws from */
+	SDL_Texture* GetTexture() const { return m_Texture; }
+
+protected:
 	SDL_Texture* m_Texture = nullptr;
 	SDL_Renderer* m_Renderer = nullptr;
 	SDL_Rect m_Rect;
 
+	// the part of the texture to draw
+	SDL_Rect m_SourceRect;
+
+	// tint and transparency, they are applied when the queue draws the sprite
+	SDL_Color m_Color;
+
+	RenderQueue::Layer m_Layer;
+
 };
 
 #endif
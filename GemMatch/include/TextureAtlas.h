@@ -0,0 +1,61 @@
+#ifndef __TEXTURE_ATLAS_H__
+#define __TEXTURE_ATLAS_H__
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*! Packs many small images into a single texture.
+*	Sprites that draw parts of the same texture let the renderer draw a whole board
+*	without switching textures. Images are added first and packed at once by Build().
+*/
+class TextureAtlas
+{
+public:
+	TextureAtlas();
+	virtual ~TextureAtlas();
+
+	/*! \brief Loads an image that gets packed by the next Build()
+	*
+	*	\param file The path of the image, also the name of its region
+	*/
+	void AddImage(const std::string& file);
+
+	/*! \brief Packs all added images into one texture, meant to be called once at startup
+	*
+	*	Images are placed in rows, highest first, with a gap of one pixel between them.
+	*
+	*	\return false if the texture could not be created
+	*/
+	bool Build();
+
+	/*! \brief Retrieves the part of the texture that holds an image
+	*
+	*	\param file The path the image has been added with
+	*	\param region Receives the rectangle in texture coordinates
+	*	\return false if there is no such image
+	*/
+	bool GetRegion(const std::string& file, SDL_Rect& region) const;
+
+	// returns the packed texture, nullptr before Build()
+	SDL_Texture* GetTexture() const { return m_Texture; }
+
+private:
+	// the images waiting to be packed and the paths they have been loaded from
+	std::vector<SDL_Surface*> m_Surfaces;
+	std::vector<std::string> m_Files;
+
+	// region of each image in the texture
+	std::unordered_map<std::string, SDL_Rect> m_Regions;
+
+	SDL_Texture* m_Texture;
+	SDL_Renderer* m_Renderer;
+
+	// widest row of the texture in pixels
+	static const int MAX_WIDTH = 256;
+	// empty pixels around each image
+	static const int PADDING = 1;
+};
+
+#endif
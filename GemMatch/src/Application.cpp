@@ -1,13 +1,19 @@
+#include <algorithm>
 #include <functional>
 #include <SDL_image.h>
 #include "Log.h"
 #include "Sprite.h"
+#include "AtlasSprite.h"
+#include "TextureAtlas.h"
+#include "RenderQueue.h"
 #include "Label.h"
 #include "GemFactory.h"
 #include "InputManager.h"
 #include "BoardModel.h"
 #include "BoardView.h"
 #include "BoardController.h"
+#include "SearchBot.h"
+#include "MonteCarloBot.h"
 #include "CountdownTimer.h"
 
 #include "Application.h"
@@ -50,6 +56,10 @@ bool Application::Initialize()
 		return false;
 	}
 
+	// the driver may not support vsync, then the main loop has to limit the frame rate itself
+	SDL_RendererInfo rendererInfo;
+	m_HasVSync = SDL_GetRendererInfo(m_Renderer, &rendererInfo) == 0 && (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+
 	// initialize PNG loader
 	if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG){
 		logger->LogSDLError("Failed to initialize the PNG loader");
@@ -62,9 +72,20 @@ bool Application::Initialize()
 		return 1;
 	}
 
+	// sprites and labels submit their draw calls here
+	m_RenderQueue = new RenderQueue(m_Renderer);
+
 	// load background image
 	m_Background = new Sprite();
 	m_Background->Load(BACKGROUND_PATH);
+	m_Background->SetLayer(RenderQueue::Layer::Background);
+
+	// pack the small sprites into a single texture, so drawing them needs no texture switches
+	m_Atlas = new TextureAtlas();
+	m_Atlas->AddImage(OVERLAY_PATH);
+	BoardView::AddImages(*m_Atlas);
+	if (m_Atlas->Build() == false)
+		return false;
 
 	// create the board controller
 	m_BoardController = new BoardController();
@@ -72,6 +93,10 @@ bool Application::Initialize()
 	m_BoardController->Initialize();
 	m_BoardController->Freeze(true);
 
+	// the board caches the gems together with the background below them
+	if (BuildStaticLayer() == true)
+		m_BoardController->GetView()->SetBackground(m_StaticLayer);
+
 	// create and setup a countdown timer
 	m_CountdownTimer = new CountdownTimer(60);
 	m_CountdownTimer->SetInterval(1000);
@@ -79,32 +104,36 @@ bool Application::Initialize()
 	m_CountdownTimer->SetFinishedHandler(std::bind(&Application::OnCountdownFinished, this));
 
 	// setup overlay for start and game over screen
-	m_OverlayBackground = new Sprite();
-	m_OverlayBackground->Load(OVERLAY_PATH);
+	m_OverlayBackground = new AtlasSprite(*m_Atlas, OVERLAY_PATH);
 	m_OverlayBackground->SetWidth(m_WindowWidth);
 	m_OverlayBackground->SetHeight(m_WindowHeight);
+	m_OverlayBackground->SetLayer(RenderQueue::Layer::Overlay);
 
 	// labels for start screen
 	m_WelcomeLabel = new Label(40);
 	m_WelcomeLabel->SetText("Welcome to Gem Match");
 	m_WelcomeLabel->SetColor(0, 60, 80);
 	m_WelcomeLabel->SetPosition(50, 100);
+	m_WelcomeLabel->SetLayer(RenderQueue::Layer::OverlayText);
 
 	m_StartGameLabel = new Label(30);
 	m_StartGameLabel->SetText("Press <Space> to start");
 	m_StartGameLabel->SetColor(10, 120, 10);
 	m_StartGameLabel->SetPosition(100, 400);
+	m_StartGameLabel->SetLayer(RenderQueue::Layer::OverlayText);
 
 	//labels for game over screen
 	m_GameOverLabel = new Label(70);
 	m_GameOverLabel->SetText("Game Over");
 	m_GameOverLabel->SetColor(120, 0, 0);
 	m_GameOverLabel->SetPosition(100, 100);
+	m_GameOverLabel->SetLayer(RenderQueue::Layer::OverlayText);
 
 	m_PlayAgainLabel = new Label(30);
 	m_PlayAgainLabel->SetText("Press <Space> to play again");
 	m_PlayAgainLabel->SetColor(10, 120, 10);
 	m_PlayAgainLabel->SetPosition(100, 400);
+	m_PlayAgainLabel->SetLayer(RenderQueue::Layer::OverlayText);
 
 	// game has not started yet
 	m_HasGameStarted = false;
@@ -112,6 +141,8 @@ bool Application::Initialize()
 	m_HasGameFinished = false;
 	// game is now up and running
 	m_IsRunning = true;
+	// the first frame is always drawn
+	m_NeedsRedraw = true;
 
 	return true;
 }
@@ -126,6 +157,10 @@ void Application::CleanUp()
 	delete m_CountdownTimer;
 	delete m_Background;
 	delete m_BoardController;
+	delete m_Atlas;
+	delete m_RenderQueue;
+	if (m_StaticLayer != nullptr)
+		SDL_DestroyTexture(m_StaticLayer);
 	SDL_DestroyRenderer(m_Renderer);
 	SDL_DestroyWindow(m_Window);
 
@@ -135,17 +170,26 @@ void Application::CleanUp()
 	SDL_Quit();
 }
 
-void Application::Update()
+void Application::Update(const double& deltaTime)
 {
-	m_BoardController->Update();
-	m_CountdownTimer->Update();
+	m_BoardController->Update(deltaTime);
+	m_CountdownTimer->Update(deltaTime);
 }
 
 void Application::Render()
 {
-	SDL_RenderClear(m_Renderer);
-	
-	m_Background->Render();
+	if (m_StaticLayer != nullptr)
+	{
+		SDL_Rect windowRect = { 0, 0, (int)m_WindowWidth, (int)m_WindowHeight };
+		SDL_Color white = { 255, 255, 255, 255 };
+		m_RenderQueue->Submit(m_StaticLayer, NULL, windowRect, white, RenderQueue::Layer::Background);
+	}
+	else
+	{
+		SDL_RenderClear(m_Renderer);
+		m_Background->Render();
+	}
+
 	m_BoardController->GetView()->Render();
 	m_CountdownTimer->Render();
 
@@ -164,11 +208,43 @@ void Application::Render()
 		m_GameOverLabel->Render();
 		m_PlayAgainLabel->Render();
 	}
+
+	// draw the submitted sprites and labels sorted by layer and texture
+	m_RenderQueue->Flush();
 	
 	// render everything to screen
 	SDL_RenderPresent(m_Renderer);
 }
 
+bool Application::BuildStaticLayer()
+{
+	if (m_StaticLayer == nullptr)
+	{
+		if (SDL_RenderTargetSupported(m_Renderer) == SDL_FALSE)
+			return false;
+
+		m_StaticLayer = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, m_WindowWidth, m_WindowHeight);
+		if (m_StaticLayer == nullptr)
+		{
+			Log::GetInstance()->LogSDLError("Could not create the static layer, the background is drawn every frame");
+			return false;
+		}
+
+		// the layer is opaque and replaces everything below it
+		SDL_SetTextureBlendMode(m_StaticLayer, SDL_BLENDMODE_NONE);
+	}
+
+	SDL_SetRenderTarget(m_Renderer, m_StaticLayer);
+	SDL_RenderClear(m_Renderer);
+
+	m_Background->Render();
+	m_RenderQueue->Flush();
+
+	SDL_SetRenderTarget(m_Renderer, NULL);
+
+	return true;
+}
+
 void Application::OnEvent(SDL_Event* in_Event)
 {
 	if (in_Event->type == SDL_QUIT)
@@ -200,18 +276,33 @@ int Application::Execute(int argc, char* argv[])
 	
 	SDL_Event event;
 
+	// the logic runs in fixed steps, driven by the high resolution clock
+	const double stepTime = 1.0 / m_LogicRate;
+	m_CounterFrequency = SDL_GetPerformanceFrequency();
+	m_FrameStartCounter = SDL_GetPerformanceCounter();
+
 	// main loop
 	while (m_IsRunning)
 	{
 		// poll sdl events
 		while (SDL_PollEvent(&event) != 0)
 		{
+			// input and window events may change what is on screen
+			m_NeedsRedraw = true;
+
 			// check if user closes application
 			if (event.type == SDL_QUIT)
 			{
 				m_IsRunning = false;
 			}
 
+			// some renderers lose the contents of their target textures, e.g. when the window is resized or the device is lost
+			if (event.type == SDL_RENDER_TARGETS_RESET && m_StaticLayer != nullptr)
+			{
+				BuildStaticLayer();
+				m_BoardController->GetView()->Invalidate();
+			}
+
 			// check if user pressed the space bar
 			if (event.type == SDL_KEYDOWN)
 			{
@@ -240,25 +331,60 @@ int Application::Execute(int argc, char* argv[])
 
 					m_HasGameFinished = false;
 				}
+
+				// let a bot take over or give control back to the user
+				if (event.key.keysym.sym == SDLK_b)
+					m_BoardController->SetBotPlayer(m_BoardController->IsBotEnabled() ? nullptr : new SearchBot());
+				if (event.key.keysym.sym == SDLK_m)
+					m_BoardController->SetBotPlayer(m_BoardController->IsBotEnabled() ? nullptr : new MonteCarloBot());
 			}
 
 			// send all events to the input manager
 			m_InputMgr->OnEvent(&event);
 		}
 
-		// update logic
-		Update();
+		// time since the last frame, including the time spent waiting
+		uint64_t currentCounter = SDL_GetPerformanceCounter();
+		double frameTime = (double)(currentCounter - m_FrameStartCounter) / m_CounterFrequency;
+		m_FrameStartCounter = currentCounter;
 
-		// render
-		Render();
+		// update logic as many steps as fit into the passed time, the rest is carried over
+		m_AccumulatedTime += std::min(frameTime, m_MaxFrameTime / 1000.0);
+		while (m_AccumulatedTime >= stepTime)
+		{
+			Update(stepTime);
+			m_AccumulatedTime -= stepTime;
+		}
+
+		bool isIdle = m_BoardController->IsIdle();
+
+		// render only if something moves or has changed
+		bool hasChanged = m_NeedsRedraw || m_BoardController->GetView()->HasChanged() || m_CountdownTimer->HasChanged();
+		if (isIdle == false || hasChanged == true)
+		{
+			Render();
+			m_NeedsRedraw = false;
+		}
 
-		// maintain target frame rate
-		m_DelayTime = m_WaitTime - (SDL_GetTicks() - m_FrameStartTime);
-		if (m_DelayTime > 0)
+		if (isIdle == true && hasChanged == false)
 		{
-			SDL_Delay(m_DelayTime);
+			// nothing to do until the next event or the next tick of the countdown, -1 waits for an event only.
+			// a running countdown wakes the loop before the frame time gets clamped, so it does not lose time
+			int32_t timeout = m_CountdownTimer->GetTimeUntilNextTick();
+			if (timeout >= 0)
+				timeout = std::min<int32_t>(timeout, m_MaxFrameTime);
+
+			SDL_WaitEventTimeout(NULL, timeout);
+		}
+		else if (m_HasVSync == false)
+		{
+			// maintain target frame rate, with vsync presenting the frame already waits for the display
+			double remainingTime = 1.0 / m_TargetFrameRate - (double)(SDL_GetPerformanceCounter() - m_FrameStartCounter) / m_CounterFrequency;
+			if (remainingTime > 0.0)
+			{
+				SDL_Delay((uint32_t)(remainingTime * 1000.0));
+			}
 		}
-		m_FrameStartTime = SDL_GetTicks();
 	}
 
 	// free resources
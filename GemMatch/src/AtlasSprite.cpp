@@ -0,0 +1,26 @@
+#include "Log.h"
+#include "TextureAtlas.h"
+#include "AtlasSprite.h"
+
+AtlasSprite::AtlasSprite(const TextureAtlas& atlas, const std::string& file)
+{
+	m_Texture = atlas.GetTexture();
+
+	if (atlas.GetRegion(file, m_SourceRect) == false)
+	{
+		Log::GetInstance()->LogMessage("Image is not part of the texture atlas: " + file);
+		m_SourceRect.x = m_SourceRect.y = m_SourceRect.w = m_SourceRect.h = 0;
+	}
+
+	// draw at the original size by default
+	m_Rect.x = 0;
+	m_Rect.y = 0;
+	m_Rect.w = m_SourceRect.w;
+	m_Rect.h = m_SourceRect.h;
+}
+
+AtlasSprite::~AtlasSprite()
+{
+	// the texture belongs to the atlas
+	m_Texture = nullptr;
+}
@@ -1,17 +1,23 @@
 #include <iostream>
+#include <chrono>
 #include "BoardModel.h"
 #include "BoardView.h"
+#include "IBotPlayer.h"
+#include "Application.h"
 
 #include "BoardController.h"
 
 BoardController::BoardController() :
 	m_BoardState(BoardState::Uninitialized),
 	m_Board(new BoardModel(8,8)),
-	m_View(new BoardView(8,8)),
-	m_DropDelay(100),
-	m_DropStartTime(0),
-	m_RemoveSequenceDelay(250),
-	m_RemoveSequenceStartTime(0)
+	m_View(new BoardView(8, 8, *Application::GetInstance()->GetAtlas())),
+	m_DropDelay(0.1),
+	m_DropTime(0.0),
+	m_DropMode(DropMode::RowByRow),
+	m_RemoveSequenceDelay(0.25),
+	m_RemoveSequenceTime(0.0),
+	m_BotPlayer(nullptr),
+	m_BotSearchHash(0)
 {
 	// set view properties
 	m_View->SetPosition(330, 110);
@@ -21,15 +27,17 @@ BoardController::BoardController() :
 	// register callbacks
 	m_View->SetGemsSelectedHandler(
 		std::bind(&BoardController::OnGemsSelected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
-	m_Board->SetColorAddedHandler(std::bind(&BoardController::OnColorAdded, this, std::placeholders::_1, std::placeholders::_2));
-	m_Board->SetColorRemovedHandler(std::bind(&BoardController::OnColorRemoved, this, std::placeholders::_1, std::placeholders::_2));
-	m_Board->SetColorDroppedHandler(std::bind(&BoardController::OnColorDropped, this, std::placeholders::_1, std::placeholders::_2));
-	m_Board->SetSequenceFoundHandler(std::bind(&BoardController::OnSequenceFound, this, std::placeholders::_1, std::placeholders::_2));
+
+	// the model collects its changes, they get applied to the view after each step
+	m_Board->SetRecordedDeltas(BoardDelta::AllTypes);
 }
 
 
 BoardController::~BoardController()
 {
+	// the search must not outlive the bot
+	CancelBotSearch();
+	delete m_BotPlayer;
 
 	delete m_View;
 	delete m_Board;
@@ -37,25 +45,33 @@ BoardController::~BoardController()
 
 void BoardController::Initialize()
 {
-	// populate the board
+	// populate the board, it always contains a valid move
 	m_Board->Populate();
 
+	RebuildView();
+
+	// controller is ready for playing
+	m_BoardState = BoardState::Ready;
+}
+
+void BoardController::RebuildView()
+{
 	// board dimensions
-	uint8_t columns = m_Board->GetColumns();
-	uint8_t rows = m_Board->GetRows();
+	uint16_t columns = m_Board->GetColumns();
+	uint16_t rows = m_Board->GetRows();
 
-	// add a gem representation to the view 
+	// replace the gem representation of every cell
 	for (int y = 0; y < rows; ++y)
 	{
 		for (int x = 0; x < columns; ++x)
 		{
+			// release the previous gem, so the factory can recycle it
+			m_View->RemovedGem(x, y);
+
 			uint8_t color = m_Board->GetColor(x, y);
 			m_View->AddGem(x, y, Gem::Color(color));
 		}
 	}
-
-	// controller is ready for playing
-	m_BoardState = BoardState::Ready;
 }
 
 void BoardController::Freeze(bool const& isFreezed)
@@ -68,7 +84,7 @@ void BoardController::Freeze(bool const& isFreezed)
 		m_BoardState = BoardState::Ready;
 }
 
-void BoardController::Update()
+void BoardController::Update(const double& deltaTime)
 {
 	switch (m_BoardState)
 	{
@@ -78,9 +94,19 @@ void BoardController::Update()
 			m_View->EnableInput(false);
 		break;
 	case BoardState::Ready:
+		if (m_BotPlayer != nullptr)
+		{
+			// the bot replaces the mouse selection
+			if (m_View->IsInputEnabled() == true)
+				m_View->EnableInput(false);
+
+			UpdateBot();
+		}
 		// make sure view is accepting input
-		if (m_View->IsInputEnabled() == false)
+		else if (m_View->IsInputEnabled() == false)
+		{
 			m_View->EnableInput(true);
+		}
 		break;
 	case BoardState::GemsSelected:
 		// try to swap selected gems
@@ -92,11 +118,11 @@ void BoardController::Update()
 		break;
 	case BoardState::SequenceDetected:
 		// remove all sequences
-		RemoveSequences();
+		RemoveSequences(deltaTime);
 		break;
 	case BoardState::SequencesRemoved:
 		//drop gems one row at a time until no more holes are left
-		DropGems();
+		DropGems(deltaTime);
 		break;
 	case BoardState::GemsDopped:
 		// find sequences
@@ -114,7 +140,63 @@ void BoardController::Update()
 	*/
 }
 
-void BoardController::OnGemsSelected(const uint8_t& sourceX, const uint8_t& sourceY, const uint8_t& targetX, const uint8_t& targetY)
+bool BoardController::IsIdle() const
+{
+	if (m_BoardState == BoardState::Freeze)
+		return true;
+
+	// a bot keeps playing by itself
+	if (m_BoardState == BoardState::Ready)
+		return m_BotPlayer == nullptr;
+
+	// every other state resolves a swap step by step
+	return false;
+}
+
+void BoardController::SetBotPlayer(IBotPlayer* botPlayer)
+{
+	CancelBotSearch();
+
+	delete m_BotPlayer;
+	m_BotPlayer = botPlayer;
+}
+
+void BoardController::UpdateBot()
+{
+	if (m_BotSearch.valid() == false)
+	{
+		// the bot searches on its own copy, so the board can be played and rendered meanwhile
+		BoardModel board(*m_Board);
+		IBotPlayer* botPlayer = m_BotPlayer;
+		BoardModel::Move* botMove = &m_BotMove;
+
+		m_BotSearchHash = m_Board->GetHash();
+		m_BotSearch = std::async(std::launch::async, [botPlayer, board, botMove]() { return botPlayer->ChooseMove(board, *botMove); });
+		return;
+	}
+
+	// keep the frame going while the bot is still thinking
+	if (m_BotSearch.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+
+	bool hasMove = m_BotSearch.get();
+
+	// the board may have been populated again during the search, then the next update starts a new one
+	if (hasMove == true && m_BotSearchHash == m_Board->GetHash())
+		OnGemsSelected(m_BotMove.sourceX, m_BotMove.sourceY, m_BotMove.targetX, m_BotMove.targetY);
+}
+
+void BoardController::CancelBotSearch()
+{
+	if (m_BotSearch.valid() == true)
+	{
+		// a search can not be interrupted, it ends within the time budget of the bot
+		m_BotSearch.wait();
+		m_BotSearch = std::future<bool>();
+	}
+}
+
+void BoardController::OnGemsSelected(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY)
 {
 	// store coordinates of source and target cell
 	m_SelectedSourceCellX = sourceX;
@@ -155,61 +237,70 @@ void BoardController::FindSequences()
 {
 	// find matching color sequences
 	m_Board->DetectColorSequences();
+	ApplyDeltas();
 
 	if (m_Board->ContainsSequences() == true)
+	{
 		m_BoardState = BoardState::SequenceDetected;
+	}
 	else
+	{
+		// the board has settled, rearrange it if the player is stuck
+		if (m_Board->HasMoves() == false)
+		{
+			m_Board->Shuffle();
+			RebuildView();
+		}
+
 		m_BoardState = BoardState::Ready;
+	}
 }
 
-void BoardController::RemoveSequences()
+void BoardController::RemoveSequences(const double& deltaTime)
 {
 	// add some delay before gems are removed:
 	// the user get a better understanding of the action as removed gems get highlighted in the view 
-	if (m_RemoveSequenceStartTime == 0)
-	{
-		m_RemoveSequenceStartTime = SDL_GetTicks();
-	}
-	else
-	{
-		int currentTime = SDL_GetTicks();
+	m_RemoveSequenceTime += deltaTime;
 
-		// if delay is over, indicate that all sequences have been removed
-		if (currentTime - m_RemoveSequenceDelay > m_RemoveSequenceStartTime)
-		{
-			// remove all sequences
-			m_Board->RemoveSequences();
+	// if delay is over, indicate that all sequences have been removed
+	if (m_RemoveSequenceTime >= m_RemoveSequenceDelay)
+	{
+		// remove all sequences
+		m_Board->RemoveSequences();
+		ApplyDeltas();
 
-			m_BoardState = BoardState::SequencesRemoved;
+		m_BoardState = BoardState::SequencesRemoved;
 
-			// reset start time
-			m_RemoveSequenceStartTime = 0;
-		}
+		// reset the delay
+		m_RemoveSequenceTime = 0.0;
 	}
 }
 
-void BoardController::DropGems()
+void BoardController::DropGems(const double& deltaTime)
 {
 	// as long as there are any holes in the board, keep dropping colors
 	if (m_Board->GetHoles() > 0)
 	{
 		// add some delay each time gems are dropped
-		if (m_DropStartTime == 0)
-		{
-			m_DropStartTime = SDL_GetTicks();
-		}
-		else
+		m_DropTime += deltaTime;
+
+		if (m_DropTime >= m_DropDelay)
 		{
-			int currentTime = SDL_GetTicks();
-			if (currentTime - m_DropDelay > m_DropStartTime)
+			if (m_DropMode == DropMode::Compact)
+			{
+				// close all holes at once
+				m_Board->CompactColors(m_DropMoves);
+				ApplyDropMoves();
+			}
+			else
 			{
 				m_Board->DropColors();
-
-				// reset start time
-				m_DropStartTime = 0;
+				ApplyDeltas();
 			}
+
+			// reset the delay
+			m_DropTime = 0.0;
 		}
-		
 	}
 	else
 	{
@@ -217,7 +308,49 @@ void BoardController::DropGems()
 	}	
 }
 
-void BoardController::OnColorAdded(const uint8_t& Column, const uint8_t& Row)
+void BoardController::ApplyDeltas()
+{
+	for (const BoardDelta& delta : m_Board->GetDeltas())
+	{
+		switch (delta.type)
+		{
+		case BoardDelta::Type::ColorAdded:
+			OnColorAdded(delta.column, delta.row);
+			break;
+		case BoardDelta::Type::ColorRemoved:
+			OnColorRemoved(delta.column, delta.row);
+			break;
+		case BoardDelta::Type::ColorDropped:
+			OnColorDropped(delta.column, delta.row);
+			break;
+		case BoardDelta::Type::SequenceFound:
+			OnSequenceFound(delta.column, delta.row);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void BoardController::ApplyDropMoves()
+{
+	// moves are ordered from bottom to top, so a gem never lands on a gem that still has to move
+	for (const BoardModel::DropMove& move : m_DropMoves)
+	{
+		if (move.isSpawned)
+		{
+			uint8_t color = m_Board->GetColor(move.column, move.toRow);
+			m_View->AddGem(move.column, move.toRow, Gem::Color(color));
+		}
+		else
+		{
+			Gem* gem = m_View->GetGem(move.column, move.fromRow);
+			m_View->MoveGem(gem, move.column, move.toRow);
+		}
+	}
+}
+
+void BoardController::OnColorAdded(const uint16_t& Column, const uint16_t& Row)
 {
 	// retrieve color
 	uint8_t color = m_Board->GetColor(Column, Row);
@@ -226,14 +359,14 @@ void BoardController::OnColorAdded(const uint8_t& Column, const uint8_t& Row)
 	m_View->AddGem(Column, Row, Gem::Color(color));
 }
 
-void BoardController::OnColorRemoved(uint8_t const& column, uint8_t const& row)
+void BoardController::OnColorRemoved(uint16_t const& column, uint16_t const& row)
 {
 	// gems that are going to be removed get hightlighted
 	m_View->RemovedGem(column, row);
 }
 
 
-void BoardController::OnColorDropped(const uint8_t& column, const uint8_t& row)
+void BoardController::OnColorDropped(const uint16_t& column, const uint16_t& row)
 {
 	//retrieve gem at position
 	Gem* gem = m_View->GetGem(column, row);
@@ -241,7 +374,7 @@ void BoardController::OnColorDropped(const uint8_t& column, const uint8_t& row)
 	m_View->MoveGem(gem, column, row + 1);
 }
 
-void BoardController::OnSequenceFound(const uint8_t& column, const uint8_t& row)
+void BoardController::OnSequenceFound(const uint16_t& column, const uint16_t& row)
 {
 	m_View->MarkRemovedGem(column, row);
 }
\ No newline at end of file
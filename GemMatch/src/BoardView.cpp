@@ -4,12 +4,17 @@
 #include <InputManager.h>
 #include "IMouseListener.h"
 #include "GemFactory.h"
+#include "AtlasSprite.h"
+#include "TextureAtlas.h"
+#include "RenderQueue.h"
+#include "Application.h"
+#include "Log.h"
 #include "BoardView.h"
 
 const std::string BoardView::SELECTION_CURSOR_PATH = "assets/sprites/cursor.png";
 const std::string BoardView::REMOVE_SPRITE_PATH = "assets/sprites/highlight.png";
 
-BoardView::BoardView(const uint8_t& columns, const uint8_t& rows) :
+BoardView::BoardView(const uint16_t& columns, const uint16_t& rows, const TextureAtlas& atlas) :
 	m_Columns(columns),
 	m_Rows(rows),
 	m_PosX(0),
@@ -21,22 +26,37 @@ BoardView::BoardView(const uint8_t& columns, const uint8_t& rows) :
 	m_CellHeight(0),
 	m_MousePosX(0),
 	m_MousePosY(0),
-	m_GemFactory(new GemFactory()),
-	m_SelectionCursor(new Sprite),
-	m_RemoveHighlight(new Sprite),
-	m_State(State::SelectFirstGem)
+	m_GemFactory(new GemFactory(atlas)),
+	m_SelectionCursor(new AtlasSprite(atlas, SELECTION_CURSOR_PATH)),
+	m_RemoveHighlight(new AtlasSprite(atlas, REMOVE_SPRITE_PATH)),
+	m_State(State::SelectFirstGem),
+	m_BoardQueue(new RenderQueue(Application::GetInstance()->GetRenderer())),
+	m_IsCachingSupported(true),
+	m_DirtyCells(columns * rows, true),
+	m_HasDirtyCells(true),
+	m_IsBoardDirty(true)
 {
 	// listen for mouse events
 	InputManager::GetInstance()->AddMouseListener(this);
 
-	// create array of gems
-	m_Gems = new Gem*[m_Columns * m_Rows];
+	// create array of gems, all cells start empty
+	m_Gems = new Gem*[m_Columns * m_Rows]();
 
 	// calculate cell dimensions
 	m_CellWidth = m_Width / m_Columns;
 	m_CellHeight = m_Height / m_Rows;
-	m_SelectionCursor->Load(SELECTION_CURSOR_PATH);
-	m_RemoveHighlight->Load(REMOVE_SPRITE_PATH);
+
+	// cursor and highlight cover the gems, so all gems can be drawn before them
+	m_SelectionCursor->SetLayer(RenderQueue::Layer::BoardHighlight);
+	m_RemoveHighlight->SetLayer(RenderQueue::Layer::BoardHighlight);
+}
+
+void BoardView::AddImages(TextureAtlas& atlas)
+{
+	GemFactory::AddImages(atlas);
+
+	atlas.AddImage(SELECTION_CURSOR_PATH);
+	atlas.AddImage(REMOVE_SPRITE_PATH);
 }
 
 
@@ -46,6 +66,11 @@ BoardView::~BoardView()
 	InputManager::GetInstance()->RemoveMouseListener(this);
 	// delete gem array
 	delete[] m_Gems;
+
+	if (m_BoardTexture != nullptr)
+		SDL_DestroyTexture(m_BoardTexture);
+
+	delete m_BoardQueue;
 	delete m_RemoveHighlight;
 	delete m_SelectionCursor;
 	delete m_GemFactory;
@@ -56,6 +81,9 @@ void BoardView::SetPosition(const int& x, const int& y)
 {
 	m_PosX = x;
 	m_PosY = y;
+
+	// another part of the background lies below the board now
+	Invalidate();
 }
 
 void BoardView::SetWidth(const int& width)
@@ -64,6 +92,13 @@ void BoardView::SetWidth(const int& width)
 
 	// update cell width
 	m_CellWidth = m_Width / m_Columns;
+
+	// the board texture gets created with the new size
+	if (m_BoardTexture != nullptr)
+	{
+		SDL_DestroyTexture(m_BoardTexture);
+		m_BoardTexture = nullptr;
+	}
 }
 
 void BoardView::SetHeight(const int& height)
@@ -72,6 +107,13 @@ void BoardView::SetHeight(const int& height)
 
 	// update cell height
 	m_CellHeight = m_Height / m_Rows;
+
+	// the board texture gets created with the new size
+	if (m_BoardTexture != nullptr)
+	{
+		SDL_DestroyTexture(m_BoardTexture);
+		m_BoardTexture = nullptr;
+	}
 }
 
 Gem* BoardView::GetGem(uint32_t const& column, uint32_t const& row) const
@@ -90,6 +132,7 @@ void BoardView::AddGem(const uint32_t& column, const uint32_t& row, const Gem::C
 	{
 		// get a gem from the factory
 		m_Gems[row * m_Columns + column] = m_GemFactory->GetGem(color);
+		MarkCellDirty(row * m_Columns + column);
 	}
 }
 
@@ -99,6 +142,7 @@ void BoardView::MarkRemovedGem(const uint32_t& column, const uint32_t& row)
 	{
 		Gem* gem = m_Gems[row * m_Columns + column];
 		gem->SetState(Gem::State::Removed);
+		MarkCellDirty(row * m_Columns + column);
 	}
 }
 
@@ -114,15 +158,17 @@ void BoardView::RemovedGem(const uint32_t& column, const uint32_t& row)
 
 		// remove gem
 		m_Gems[row * m_Columns + column] = nullptr;
+		MarkCellDirty(row * m_Columns + column);
 	}
 }
 
-void BoardView::MoveGem(Gem* gem, const uint8_t& targetColumn, const uint8_t& targetRow)
+void BoardView::MoveGem(Gem* gem, const uint16_t& targetColumn, const uint16_t& targetRow)
 {
 	// cell exists, move the gem there
 	if (targetRow >= 0 && targetRow < m_Rows && targetColumn >= 0 && targetColumn < m_Columns)
 	{
 		m_Gems[targetRow * m_Columns + targetColumn] = gem;
+		MarkCellDirty(targetRow * m_Columns + targetColumn);
 
 	}
 }
@@ -143,7 +189,7 @@ bool const BoardView::IsInputEnabled()
 		return true;
 }
 
-void BoardView::SetGemsSelectedHandler(std::function<void(const uint8_t&, const uint8_t&, const uint8_t&, const uint8_t&)> handlerFunction)
+void BoardView::SetGemsSelectedHandler(std::function<void(const uint16_t&, const uint16_t&, const uint16_t&, const uint16_t&)> handlerFunction)
 {
 	GemsSelected = handlerFunction;
 }
@@ -161,14 +207,14 @@ void BoardView::OnMouseMove(const uint32_t& mouseX, const uint32_t& mouseY)
 	if (IsMouseOverBoard() == true)
 	{
 		// determine the cell the mouse is hovering
-		uint8_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
-		uint8_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
+		uint16_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
+		uint16_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
 
 		if (xCell > m_Columns - 1) xCell = m_Columns - 1;
 		if (yCell > m_Rows - 1) yCell = m_Rows - 1;
 
 		//highlight new cell if mouse hovers over a different cell
-		uint8_t hoveredCell = yCell * m_Columns + xCell;
+		uint32_t hoveredCell = yCell * m_Columns + xCell;
 
 		if (m_State == State::SelectFirstGem)
 		{
@@ -179,7 +225,7 @@ void BoardView::OnMouseMove(const uint32_t& mouseX, const uint32_t& mouseY)
 			{
 				if (hoveredCell != m_HighlightedCell || highlightedGem->GetState() == Gem::State::Normal)
 				{
-					ResetCell(m_HighlightedCell % m_Columns, m_HighlightedCell / m_Rows);
+					ResetCell(m_HighlightedCell % m_Columns, m_HighlightedCell / m_Columns);
 					HighlightCell(xCell, yCell);
 				}
 			}
@@ -197,7 +243,7 @@ void BoardView::OnMouseMove(const uint32_t& mouseX, const uint32_t& mouseY)
 			if (highlightedGem->GetState() == Gem::State::Highlighted)
 			{
 				// switch off highlighting if the mouse is not over the board
-				ResetCell(m_HighlightedCell % m_Columns, m_HighlightedCell / m_Rows);
+				ResetCell(m_HighlightedCell % m_Columns, m_HighlightedCell / m_Columns);
 			}
 		}
 	}
@@ -215,8 +261,8 @@ void BoardView::OnMouseDown(SDL_Event* event)
 		m_IsLeftMouseButtonDown = true;
 
 		// determine the cell where the user clicked
-		uint8_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
-		uint8_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
+		uint16_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
+		uint16_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
 
 		if (xCell > m_Columns - 1) xCell = m_Columns - 1;
 		if (yCell > m_Rows - 1) yCell = m_Rows - 1;
@@ -227,6 +273,9 @@ void BoardView::OnMouseDown(SDL_Event* event)
 
 			m_Gems[m_FirstCell]->SetState(Gem::State::Selected);
 			m_State = State::SelectSecondGem;
+
+			// the selected gem is drawn on top of the board texture from now on
+			MarkCellDirty(m_FirstCell);
 		}
 	}
 }
@@ -245,8 +294,8 @@ void BoardView::OnMouseReleased(SDL_Event* event)
 		if (IsMouseOverBoard() == true)
 		{
 			// determine the cell where the mouse button was released
-			uint8_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
-			uint8_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
+			uint16_t xCell = (m_MousePosX - m_PosX) / m_CellWidth;
+			uint16_t yCell = (m_MousePosY - m_PosY) / m_CellHeight;
 
 			if (xCell > m_Columns - 1) xCell = m_Columns - 1;
 			if (yCell > m_Rows - 1) yCell = m_Rows - 1;
@@ -258,11 +307,12 @@ void BoardView::OnMouseReleased(SDL_Event* event)
 			if (m_State == State::SelectSecondGem && m_FirstCell != releasedCell)
 			{
 				// invoke gems selected event
-				//GemsSelected(m_FirstCell % m_Columns, m_FirstCell / m_Rows, releasedCell % m_Columns, releasedCell / m_Rows);
+				//GemsSelected(m_FirstCell % m_Columns, m_FirstCell / m_Columns, releasedCell % m_Columns, releasedCell / m_Columns);
 				SwapCells(m_FirstCell, releasedCell);
 
 				m_Gems[m_FirstCell]->SetState(Gem::State::Normal);
 				m_State = State::SelectFirstGem;
+				MarkCellDirty(m_FirstCell);
 				
 			}
 
@@ -275,23 +325,25 @@ void BoardView::OnMouseReleased(SDL_Event* event)
 	}
 }
 
-void BoardView::HighlightCell(const uint8_t& column, const uint8_t& row)
+void BoardView::HighlightCell(const uint16_t& column, const uint16_t& row)
 {
 	uint32_t cellID = row * m_Columns + column;
 
 	if (m_Gems[cellID] != nullptr)
 	{
 		m_Gems[cellID]->SetState(Gem::State::Highlighted);
+		MarkCellDirty(cellID);
 	}
 }
 
-void BoardView::ResetCell(const uint8_t& column, const uint8_t& row)
+void BoardView::ResetCell(const uint16_t& column, const uint16_t& row)
 {
 	uint32_t cellID = row * m_Columns + column;
 
 	if (m_Gems[cellID] != nullptr)
 	{
 		m_Gems[cellID]->SetState(Gem::State::Normal);
+		MarkCellDirty(cellID);
 	}
 }
 
@@ -299,11 +351,11 @@ void BoardView::SwapCells(const int& firstCell, const int& secondCell)
 {
 
 	// swap if cells are adjacent
-	if (((firstCell / m_Rows) == (secondCell / m_Rows) && abs(firstCell - secondCell) == 1)
+	if (((firstCell / m_Columns) == (secondCell / m_Columns) && abs(firstCell - secondCell) == 1)
 		|| abs(firstCell - secondCell) == m_Columns)
 	{
 		// invoke gems selected event
-		GemsSelected(m_FirstCell % m_Columns, m_FirstCell / m_Rows, secondCell % m_Columns, secondCell / m_Rows);
+		GemsSelected(m_FirstCell % m_Columns, m_FirstCell / m_Columns, secondCell % m_Columns, secondCell / m_Columns);
 
 	}
 }
@@ -317,34 +369,30 @@ bool BoardView::IsMouseOverBoard()
 
 void BoardView::Render()
 {
+	RenderQueue* queue = Application::GetInstance()->GetRenderQueue();
+	SDL_Color white = { 255, 255, 255, 255 };
 
-	//Draw the tiles by calculating their positions
-	for (int i = 0; i < m_Rows * m_Columns; ++i)
+	// the settled gems are drawn with a single copy of the board texture
+	if (UpdateBoardTexture() == true)
 	{
-		int x = i % m_Columns;
-		int y = i / m_Rows;
-
-		Gem* gem = m_Gems[i];
-		if (gem != nullptr)
+		SDL_Rect boardRect = { (int)m_PosX, (int)m_PosY, (int)m_Width, (int)m_Height };
+		queue->Submit(m_BoardTexture, NULL, boardRect, white, RenderQueue::Layer::Board);
+	}
+	else
+	{
+		//Draw the tiles by calculating their positions
+		for (int i = 0; i < m_Rows * m_Columns; ++i)
 		{
-			Sprite* currentSprite = gem->GetSprite();
+			int x = i % m_Columns;
+			int y = i / m_Columns;
 
-			// draw normal state
-			if (gem->GetState() == Gem::State::Normal || gem->GetState() == Gem::State::Highlighted)
-			{
-				currentSprite->SetPosition(m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
-				gem->Render();
-			}
-
-			// draw remove highlight
-			if (gem->GetState() == Gem::State::Removed)
-			{
-				currentSprite->SetPosition(m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
-				m_RemoveHighlight->SetPosition(m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
-				gem->Render();
-				m_RemoveHighlight->Render();
-			}
+			RenderCell(*queue, i, m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
 		}
+
+		// all cells are drawn anyway, only HasChanged() looks at the dirty cells
+		m_DirtyCells.assign(m_DirtyCells.size(), false);
+		m_HasDirtyCells = false;
+		m_IsBoardDirty = false;
 	}
 
 	if (m_State == State::SelectSecondGem)
@@ -352,22 +400,138 @@ void BoardView::Render()
 		Sprite* selectedSprite = m_Gems[m_FirstCell]->GetSprite();
 
 		int x = m_FirstCell % m_Columns;
-		int y = m_FirstCell / m_Rows;
+		int y = m_FirstCell / m_Columns;
 
 		if (m_IsLeftMouseButtonDown)
 		{
 			SDL_Rect rect = selectedSprite->GetRect();
 			selectedSprite->SetPosition(m_MousePosX - rect.w/2, m_MousePosY - rect.h/2);
-			m_Gems[m_FirstCell]->Render();
+			m_Gems[m_FirstCell]->Render(*queue, RenderQueue::Layer::Dragged);
 		}
 		else
 		{
 			selectedSprite->SetPosition(m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
 			m_SelectionCursor->SetPosition(m_PosX + x * m_CellWidth, m_PosY + y * m_CellHeight);
 
-			// render gem & the selection cursor
-			m_Gems[m_FirstCell]->Render();
-			m_SelectionCursor->Render();
+			// render gem & the selection cursor, both cover the board texture
+			m_Gems[m_FirstCell]->Render(*queue, RenderQueue::Layer::BoardHighlight);
+			m_SelectionCursor->Render(*queue);
+		}
+	}
+}
+
+void BoardView::RenderCell(RenderQueue& queue, const uint32_t& cell, const int& x, const int& y)
+{
+	Gem* gem = m_Gems[cell];
+	if (gem == nullptr)
+		return;
+
+	Sprite* currentSprite = gem->GetSprite();
+
+	// draw normal state
+	if (gem->GetState() == Gem::State::Normal || gem->GetState() == Gem::State::Highlighted)
+	{
+		currentSprite->SetPosition(x, y);
+		gem->Render(queue);
+	}
+
+	// draw remove highlight
+	if (gem->GetState() == Gem::State::Removed)
+	{
+		currentSprite->SetPosition(x, y);
+		m_RemoveHighlight->SetPosition(x, y);
+		gem->Render(queue);
+		m_RemoveHighlight->Render(queue);
+	}
+}
+
+void BoardView::SetBackground(SDL_Texture* background)
+{
+	m_Background = background;
+	Invalidate();
+}
+
+void BoardView::Invalidate()
+{
+	m_IsBoardDirty = true;
+}
+
+void BoardView::MarkCellDirty(const uint32_t& cell)
+{
+	m_DirtyCells[cell] = true;
+	m_HasDirtyCells = true;
+}
+
+bool BoardView::UpdateBoardTexture()
+{
+	// the cells are restored from the background, there is nothing to cache without it
+	if (m_IsCachingSupported == false || m_Background == nullptr)
+		return false;
+
+	SDL_Renderer* renderer = Application::GetInstance()->GetRenderer();
+
+	if (m_BoardTexture == nullptr)
+	{
+		if (SDL_RenderTargetSupported(renderer) == SDL_TRUE)
+			m_BoardTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, m_Width, m_Height);
+
+		if (m_BoardTexture == nullptr)
+		{
+			Log::GetInstance()->LogSDLError("Could not create the board texture, the board is drawn every frame");
+			m_IsCachingSupported = false;
+			return false;
+		}
+
+		// the texture is opaque, it replaces the background below the board
+		SDL_SetTextureBlendMode(m_BoardTexture, SDL_BLENDMODE_NONE);
+		m_IsBoardDirty = true;
+	}
+
+	if (m_IsBoardDirty == false && m_HasDirtyCells == false)
+		return true;
+
+	SDL_SetRenderTarget(renderer, m_BoardTexture);
+
+	// the background is copied as it is, its transparency must not blend with old contents
+	SDL_BlendMode backgroundBlendMode;
+	SDL_GetTextureBlendMode(m_Background, &backgroundBlendMode);
+	SDL_SetTextureBlendMode(m_Background, SDL_BLENDMODE_NONE);
+
+	if (m_IsBoardDirty == true)
+	{
+		SDL_Rect sourceRect = { (int)m_PosX, (int)m_PosY, (int)m_Width, (int)m_Height };
+		SDL_RenderCopy(renderer, m_Background, &sourceRect, NULL);
+	}
+
+	for (int i = 0; i < m_Rows * m_Columns; ++i)
+	{
+		if (m_IsBoardDirty == false && m_DirtyCells[i] == false)
+			continue;
+
+		int x = (i % m_Columns) * m_CellWidth;
+		int y = (i / m_Columns) * m_CellHeight;
+
+		// gem sprites are not larger than a cell, so the background of the cell is all they cover
+		if (m_IsBoardDirty == false)
+		{
+			SDL_Rect sourceRect = { (int)m_PosX + x, (int)m_PosY + y, (int)m_CellWidth, (int)m_CellHeight };
+			SDL_Rect cellRect = { x, y, (int)m_CellWidth, (int)m_CellHeight };
+			SDL_RenderCopy(renderer, m_Background, &sourceRect, &cellRect);
 		}
+
+		RenderCell(*m_BoardQueue, i, x, y);
+		m_DirtyCells[i] = false;
 	}
+
+	SDL_SetTextureBlendMode(m_Background, backgroundBlendMode);
+
+	// the gems are drawn after all the background copies, so they are never covered
+	m_BoardQueue->Flush();
+
+	SDL_SetRenderTarget(renderer, NULL);
+
+	m_HasDirtyCells = false;
+	m_IsBoardDirty = false;
+
+	return true;
 }
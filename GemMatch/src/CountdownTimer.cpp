@@ -1,4 +1,5 @@
 #include <SDL.h>
+#include <cmath>
 #include <string>
 #include <iostream>
 #include "Sprite.h"
@@ -8,9 +9,10 @@
 CountdownTimer::CountdownTimer(uint32_t startTime) :
 m_Time(startTime),
 m_StartTime(startTime),
-m_StartTicks(0),
+m_ElapsedTime(0.0),
 m_Interval(1000),
 m_HasStarted(false),
+m_HasChanged(true),
 m_Label(new Label(60))
 {
 	// adjust countdown label position
@@ -36,7 +38,7 @@ void CountdownTimer::SetFinishedHandler(std::function<void()> handlerFunction)
 
 void CountdownTimer::Start()
 {
-	m_StartTicks = SDL_GetTicks();
+	m_ElapsedTime = 0.0;
 	m_HasStarted = true;
 }
 
@@ -51,17 +53,27 @@ void CountdownTimer::Reset()
 	m_Time = m_StartTime;
 }
 
-void CountdownTimer::Update()
+int32_t CountdownTimer::GetTimeUntilNextTick() const
+{
+	if (m_HasStarted == false)
+		return -1;
+
+	double remainingTime = m_Interval / 1000.0 - m_ElapsedTime;
+	return (remainingTime > 0.0) ? (int32_t)std::ceil(remainingTime * 1000.0) : 0;
+}
+
+void CountdownTimer::Update(const double& deltaTime)
 {
 	if (m_HasStarted)
 	{
-		Uint32 deltaTime = SDL_GetTicks() - m_StartTicks;
+		m_ElapsedTime += deltaTime;
 
-		if (deltaTime > m_Interval)
+		if (m_ElapsedTime >= m_Interval / 1000.0)
 		{
 			if (m_Time == 0)
 			{
 				Stop();
+				m_HasChanged = true;
 
 				// callback handler
 				if (m_CountdownFinishEvent != nullptr)
@@ -77,8 +89,10 @@ void CountdownTimer::Update()
 				// update label
 				std::string labelText = std::to_string(m_Time);
 				m_Label->SetText(labelText);
+				m_HasChanged = true;
 
-				m_StartTicks = SDL_GetTicks();
+				// keep the remainder, so the intervals do not drift
+				m_ElapsedTime -= m_Interval / 1000.0;
 			}
 		}
 	}
@@ -87,4 +101,5 @@ void CountdownTimer::Update()
 void CountdownTimer::Render()
 {
 	m_Label->Render();
+	m_HasChanged = false;
 }
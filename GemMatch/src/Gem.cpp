@@ -28,7 +28,7 @@ Gem::State const& Gem::GetState()
 	return m_State;
 }
 
-void Gem::Render()
+void Gem::Render(RenderQueue& queue, const RenderQueue::Layer& layer)
 {
 	if (m_State == State::Highlighted)
 	{
@@ -39,5 +39,7 @@ void Gem::Render()
 		m_Sprite->SetColor(255, 255, 255);
 	}
 
-	m_Sprite->Render();
+	// the sprite is shared by all gems of a color, the queue keeps a copy of its state
+	m_Sprite->SetLayer(layer);
+	m_Sprite->Render(queue);
 }
\ No newline at end of file
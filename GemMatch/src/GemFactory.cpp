@@ -1,4 +1,5 @@
-#include "Sprite.h"
+#include "AtlasSprite.h"
+#include "TextureAtlas.h"
 #include "GemFactory.h"
 
 const std::string GemFactory::PATH_RED_GEM = "assets/sprites/Red.png";
@@ -7,19 +8,14 @@ const std::string GemFactory::PATH_BLUE_GEM = "assets/sprites/Blue.png";
 const std::string GemFactory::PATH_PURPLE_GEM = "assets/sprites/Purple.png";
 const std::string GemFactory::PATH_YELLOW_GEM = "assets/sprites/Yellow.png";
 
-GemFactory::GemFactory()
+GemFactory::GemFactory(const TextureAtlas& atlas)
 {
-	// create sprites for all gem colors
-	Sprite* redSprite = new Sprite();
-	redSprite->Load(PATH_RED_GEM);
-	Sprite* greenSprite = new Sprite();
-	greenSprite->Load(PATH_GREEN_GEM);
-	Sprite* blueSprite = new Sprite();
-	blueSprite->Load(PATH_BLUE_GEM);
-	Sprite* purpleSprite = new Sprite();
-	purpleSprite->Load(PATH_PURPLE_GEM);
-	Sprite* yellowSprite = new Sprite();
-	yellowSprite->Load(PATH_YELLOW_GEM);
+	// create sprites for all gem colors, they all draw from the same texture
+	Sprite* redSprite = new AtlasSprite(atlas, PATH_RED_GEM);
+	Sprite* greenSprite = new AtlasSprite(atlas, PATH_GREEN_GEM);
+	Sprite* blueSprite = new AtlasSprite(atlas, PATH_BLUE_GEM);
+	Sprite* purpleSprite = new AtlasSprite(atlas, PATH_PURPLE_GEM);
+	Sprite* yellowSprite = new AtlasSprite(atlas, PATH_YELLOW_GEM);
 
 	// add sprites to the map
 	m_ColorSpriteMap[Gem::Color::Red] = redSprite;
@@ -29,6 +25,15 @@ GemFactory::GemFactory()
 	m_ColorSpriteMap[Gem::Color::Yellow] = yellowSprite;
 }
 
+void GemFactory::AddImages(TextureAtlas& atlas)
+{
+	atlas.AddImage(PATH_RED_GEM);
+	atlas.AddImage(PATH_GREEN_GEM);
+	atlas.AddImage(PATH_BLUE_GEM);
+	atlas.AddImage(PATH_PURPLE_GEM);
+	atlas.AddImage(PATH_YELLOW_GEM);
+}
+
 GemFactory::~GemFactory()
 {
 	// clear the gem pool (gems are automatically destroyed due to unique_ptr)
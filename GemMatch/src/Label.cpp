@@ -6,7 +6,8 @@
 Label::Label(const int& size) :
 m_Color({ 255, 255, 255 }),
 m_Size(size),
-m_Renderer(Application::GetInstance()->GetRenderer())
+m_Renderer(Application::GetInstance()->GetRenderer()),
+m_Layer(RenderQueue::Layer::Interface)
 {
 	// get path to the main font
 	std::string mainFontPath = Application::GetInstance()->GetMainFontPath();
@@ -78,7 +79,8 @@ void Label::Render()
 {
 	if (m_Renderer != nullptr && m_Texture != nullptr)
 	{
-		//render the texture
-		SDL_RenderCopy(m_Renderer, m_Texture, NULL, &m_Rect);
+		// the color is part of the text texture, so it is never tinted
+		SDL_Color white = { 255, 255, 255, 255 };
+		Application::GetInstance()->GetRenderQueue()->Submit(m_Texture, NULL, m_Rect, white, m_Layer);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include "RenderQueue.h"
+
+RenderQueue::RenderQueue(SDL_Renderer* renderer) :
+m_Renderer(renderer),
+m_StateChangeCount(0)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+void RenderQueue::Submit(SDL_Texture* texture, const SDL_Rect* sourceRect, const SDL_Rect& destinationRect, const SDL_Color& color, const Layer& layer)
+{
+	if (texture == nullptr)
+		return;
+
+	Item item;
+	item.texture = texture;
+	item.hasSourceRect = sourceRect != nullptr;
+	if (item.hasSourceRect)
+		item.sourceRect = *sourceRect;
+	item.destinationRect = destinationRect;
+	item.color = color;
+	item.layer = layer;
+	item.order = (uint32_t)m_Items.size();
+
+	m_Items.push_back(item);
+}
+
+void RenderQueue::Flush()
+{
+	// group the items of each layer by texture, the submission order decides within a group
+	std::sort(m_Items.begin(), m_Items.end(), [](const Item& a, const Item& b)
+	{
+		if (a.layer != b.layer)
+			return a.layer < b.layer;
+		if (a.texture != b.texture)
+			return a.texture < b.texture;
+		return a.order < b.order;
+	});
+
+	m_StateChangeCount = 0;
+
+	for (const Item& item : m_Items)
+	{
+		TextureState& state = GetTextureState(item.texture);
+
+		if (state.color.r != item.color.r || state.color.g != item.color.g || state.color.b != item.color.b)
+		{
+			SDL_SetTextureColorMod(item.texture, item.color.r, item.color.g, item.color.b);
+			++m_StateChangeCount;
+		}
+
+		if (state.color.a != item.color.a)
+		{
+			SDL_SetTextureAlphaMod(item.texture, item.color.a);
+			++m_StateChangeCount;
+		}
+
+		state.color = item.color;
+
+		SDL_RenderCopy(m_Renderer, item.texture, item.hasSourceRect ? &item.sourceRect : NULL, &item.destinationRect);
+	}
+
+	m_Items.clear();
+
+	// textures may be destroyed or changed outside of the queue until the next frame
+	m_TextureStates.clear();
+}
+
+RenderQueue::TextureState& RenderQueue::GetTextureState(SDL_Texture* texture)
+{
+	for (TextureState& state : m_TextureStates)
+	{
+		if (state.texture == texture)
+			return state;
+	}
+
+	TextureState state;
+	state.texture = texture;
+	SDL_GetTextureColorMod(texture, &state.color.r, &state.color.g, &state.color.b);
+	SDL_GetTextureAlphaMod(texture, &state.color.a);
+
+	m_TextureStates.push_back(state);
+	return m_TextureStates.back();
+}
@@ -5,9 +5,16 @@
 #include "Sprite.h"
 
 Sprite::Sprite() :
-m_Renderer(Application::GetInstance()->GetRenderer())
+m_Renderer(Application::GetInstance()->GetRenderer()),
+m_Layer(RenderQueue::Layer::Board)
 {
+	m_Rect.x = m_Rect.y = m_Rect.w = m_Rect.h = 0;
+	m_SourceRect = m_Rect;
 
+	m_Color.r = 255;
+	m_Color.g = 255;
+	m_Color.b = 255;
+	m_Color.a = 255;
 }
 
 Sprite::~Sprite()
@@ -32,13 +39,22 @@ void Sprite::Load(const std::string &file)
 	{
 		//Query the texture to get its height and height to use
 		SDL_QueryTexture(m_Texture, NULL, NULL, &m_Rect.w, &m_Rect.h);
+
+		// draw the whole texture
+		m_SourceRect.w = m_Rect.w;
+		m_SourceRect.h = m_Rect.h;
 	}
 }
 
 void Sprite::Render()
 {
-	//render the texture
-	SDL_RenderCopy(m_Renderer, m_Texture, NULL, &m_Rect);
+	Render(*Application::GetInstance()->GetRenderQueue());
+}
+
+void Sprite::Render(RenderQueue& queue)
+{
+	// the queue sorts the draw calls and sets tint and transparency only when they change
+	queue.Submit(m_Texture, &m_SourceRect, m_Rect, m_Color, m_Layer);
 }
 
 void Sprite::SetPosition(const int &x, const int &y)
@@ -61,12 +77,14 @@ void Sprite::SetHeight(const int& height)
 
 void Sprite::SetAlpha(uint8_t const& alpha)
 {
-	SDL_SetTextureAlphaMod(m_Texture, alpha);
+	m_Color.a = alpha;
 }
 
 void Sprite::SetColor(const uint8_t& red, const uint8_t& green, const uint8_t& blue)
 {
-	SDL_SetTextureColorMod(m_Texture, red, green, blue);
+	m_Color.r = red;
+	m_Color.g = green;
+	m_Color.b = blue;
 }
 
 int Sprite::GetWidth() const
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <SDL_image.h>
+#include "Application.h"
+#include "Log.h"
+#include "TextureAtlas.h"
+
+const int TextureAtlas::MAX_WIDTH;
+const int TextureAtlas::PADDING;
+
+TextureAtlas::TextureAtlas() :
+m_Texture(nullptr),
+m_Renderer(Application::GetInstance()->GetRenderer())
+{
+
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	for (SDL_Surface* surface : m_Surfaces)
+		SDL_FreeSurface(surface);
+
+	if (m_Texture != nullptr)
+		SDL_DestroyTexture(m_Texture);
+}
+
+void TextureAtlas::AddImage(const std::string& file)
+{
+	SDL_Surface* surface = IMG_Load(file.c_str());
+
+	if (surface == nullptr)
+	{
+		Log::GetInstance()->LogSDLError("Could not load image for the texture atlas");
+		return;
+	}
+
+	m_Surfaces.push_back(surface);
+	m_Files.push_back(file);
+}
+
+bool TextureAtlas::Build()
+{
+	// highest images first, so every row wastes little space
+	std::vector<size_t> order(m_Surfaces.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [this](const size_t& a, const size_t& b) { return m_Surfaces[a]->h > m_Surfaces[b]->h; });
+
+	// place the images row by row
+	int x = PADDING;
+	int y = PADDING;
+	int rowHeight = 0;
+	int width = 0;
+
+	for (size_t index : order)
+	{
+		SDL_Surface* surface = m_Surfaces[index];
+
+		if (x + surface->w + PADDING > MAX_WIDTH && x > PADDING)
+		{
+			x = PADDING;
+			y += rowHeight + PADDING;
+			rowHeight = 0;
+		}
+
+		SDL_Rect region = { x, y, surface->w, surface->h };
+		m_Regions[m_Files[index]] = region;
+
+		x += surface->w + PADDING;
+		rowHeight = std::max(rowHeight, surface->h);
+		width = std::max(width, x);
+	}
+
+	int height = y + rowHeight + PADDING;
+
+	// copy all images into one surface, including their alpha channel
+	SDL_Surface* atlas = SDL_CreateRGBSurface(0, std::max(width, 1), std::max(height, 1), 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+	if (atlas == nullptr)
+	{
+		Log::GetInstance()->LogSDLError("Could not create the texture atlas surface");
+		return false;
+	}
+
+	for (size_t i = 0; i < m_Surfaces.size(); ++i)
+	{
+		SDL_Rect region = m_Regions[m_Files[i]];
+
+		SDL_SetSurfaceBlendMode(m_Surfaces[i], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(m_Surfaces[i], NULL, atlas, &region);
+		SDL_FreeSurface(m_Surfaces[i]);
+	}
+
+	m_Surfaces.clear();
+	m_Files.clear();
+
+	if (m_Texture != nullptr)
+		SDL_DestroyTexture(m_Texture);
+
+	m_Texture = SDL_CreateTextureFromSurface(m_Renderer, atlas);
+	SDL_FreeSurface(atlas);
+
+	if (m_Texture == nullptr)
+	{
+		Log::GetInstance()->LogSDLError("Could not create the texture atlas");
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(m_Texture, SDL_BLENDMODE_BLEND);
+
+	return true;
+}
+
+bool TextureAtlas::GetRegion(const std::string& file, SDL_Rect& region) const
+{
+	std::unordered_map<std::string, SDL_Rect>::const_iterator it = m_Regions.find(file);
+
+	if (it == m_Regions.end())
+		return false;
+
+	region = it->second;
+	return true;
+}
@@ -0,0 +1,120 @@
+#ifndef __BITBOARD_H__
+#define __BITBOARD_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! A fixed size set of bits with one bit per board cell.
+*	Cells are stored row by row, so shifting by one moves a bit to the neighbouring column
+*	and shifting by the amount of columns moves it to the neighbouring row.
+*	Boards larger than 64 cells are spread across several 64-bit words.
+*	The operations on whole boards also come with a range of words, so a change of a few rows only costs the words that hold them.
+*/
+class BitBoard
+{
+public:
+	BitBoard();
+	BitBoard(const uint32_t& bitCount);
+	virtual ~BitBoard();
+
+	/*! \brief Changes the amount of bits and clears all of them
+	*
+	*	\param bitCount The new amount of bits
+	*/
+	void Resize(const uint32_t& bitCount);
+
+	/*! Sets a single bit */
+	void Set(const uint32_t& bit) { m_Words[bit >> 6] |= (uint64_t(1) << (bit & 63)); }
+
+	/*! Clears a single bit */
+	void Reset(const uint32_t& bit) { m_Words[bit >> 6] &= ~(uint64_t(1) << (bit & 63)); }
+
+	/*! Returns the state of a single bit */
+	bool Test(const uint32_t& bit) const { return (m_Words[bit >> 6] >> (bit & 63)) & 1; }
+
+	/*! Clears all bits */
+	void Clear();
+
+	/*! \brief Clears the bits of a range of words
+	*
+	*	\param firstWord The first word of the range
+	*	\param endWord The word behind the range
+	*/
+	void Clear(const size_t& firstWord, const size_t& endWord);
+
+	/*! Returns true if at least one bit is set */
+	bool Any() const;
+
+	/*! Copies all bits of another board of the same size */
+	void Assign(const BitBoard& other);
+	void Assign(const BitBoard& other, const size_t& firstWord, const size_t& endWord);
+
+	/*! Keeps only the bits that are also set in the other board */
+	void And(const BitBoard& other);
+	void And(const BitBoard& other, const size_t& firstWord, const size_t& endWord);
+
+	/*! Adds all bits that are set in the other board */
+	void Or(const BitBoard& other);
+	void Or(const BitBoard& other, const size_t& firstWord, const size_t& endWord);
+
+	/*! \brief Keeps only the bits that are also set in the source board shifted towards bit 0
+	*
+	*	Afterwards bit i is set if it was set before and bit i + shift is set in the source
+	*
+	*	\param source The board to shift
+	*	\param shift The amount of bits to shift
+	*/
+	void AndShiftedDown(const BitBoard& source, const uint32_t& shift);
+
+	/*! \brief AndShiftedDown() for a range of words, source bits behind the range are still read
+	*
+	*	\param source The board to shift
+	*	\param shift The amount of bits to shift
+	*	\param firstWord The first word of the range
+	*	\param endWord The word behind the range
+	*/
+	void AndShiftedDown(const BitBoard& source, const uint32_t& shift, const size_t& firstWord, const size_t& endWord);
+
+	/*! \brief Adds all bits of the source board shifted away from bit 0
+	*
+	*	Afterwards bit i is set if it was set before or bit i - shift is set in the source
+	*
+	*	\param source The board to shift
+	*	\param shift The amount of bits to shift
+	*/
+	void OrShiftedUp(const BitBoard& source, const uint32_t& shift);
+
+	/*! \brief OrShiftedUp() for a range of words, source bits in front of the range are still read
+	*
+	*	\param source The board to shift
+	*	\param shift The amount of bits to shift
+	*	\param firstWord The first word of the range
+	*	\param endWord The word behind the range
+	*/
+	void OrShiftedUp(const BitBoard& source, const uint32_t& shift, const size_t& firstWord, const size_t& endWord);
+
+	/*! \brief Finds the next set bit
+	*
+	*	\param from The first bit to look at
+	*	\return The index of the first set bit at or after from, or GetBitCount() if there is none
+	*/
+	uint32_t FindNext(const uint32_t& from) const;
+
+	// returns the amount of bits
+	uint32_t GetBitCount() const { return m_BitCount; }
+
+	// returns the amount of 64-bit words
+	size_t GetWordCount() const { return m_Words.size(); }
+
+private:
+	// clears the unused bits of the last word, so that shifts never move them into the board
+	void ClearPadding();
+
+	uint32_t m_BitCount;
+
+	// the bits, 64 per word
+	std::vector<uint64_t> m_Words;
+};
+
+#endif
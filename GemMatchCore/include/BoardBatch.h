@@ -0,0 +1,144 @@
+#ifndef __BOARD_BATCH_H__
+#define __BOARD_BATCH_H__
+
+#include <cstdint>
+#include <vector>
+#include "BoardModel.h"
+#include "RandomGenerator.h"
+
+/*! Up to 32 independent boards of the same size that are resolved in lockstep.
+*	The boards are stored as structure of arrays: for every cell the colors of all boards
+*	lie next to each other, so detection, removal and gravity handle every board with
+*	the same vector instruction. AVX2 or SSE2 kernels are chosen at compile time,
+*	with a plain loop as fallback. Each board is called a lane.
+*/
+class BoardBatch
+{
+public:
+	// amount of boards in a batch
+	static const uint32_t LANE_COUNT = 32;
+
+	// color value of an empty cell
+	static const uint8_t HOLE = 0xFF;
+
+	BoardBatch(const uint8_t& columns, const uint8_t& rows);
+	virtual ~BoardBatch();
+
+	/*! \brief Copies the colors and the random generator of a board into a lane
+	*
+	*	\param lane The lane to fill
+	*	\param board A board of the same size
+	*/
+	void LoadBoard(const uint32_t& lane, BoardModel& board);
+
+	/*! \brief Retrieves the color of a cell of a lane
+	*
+	*	\param lane The board of the batch
+	*	\param column The column of the requested cell
+	*	\param row The row of the requested cell
+	*	\return The color or HOLE
+	*/
+	uint8_t GetColor(const uint32_t& lane, const uint8_t& column, const uint8_t& row) const
+	{
+		return m_Cells[(row * m_Columns + column) * LANE_COUNT + lane];
+	}
+
+	/*! \brief Changes the color of a cell of a lane
+	*
+	*	\param lane The board of the batch
+	*	\param column The column of the cell
+	*	\param row The row of the cell
+	*	\param color The new color or HOLE
+	*/
+	void SetColor(const uint32_t& lane, const uint8_t& column, const uint8_t& row, const uint8_t& color)
+	{
+		m_Cells[(row * m_Columns + column) * LANE_COUNT + lane] = color;
+	}
+
+	/*! \brief Swaps two cells of a lane without checking whether the swap creates a sequence
+	*
+	*	\param lane The board of the batch
+	*	\param move The cells to swap
+	*/
+	void ApplyMove(const uint32_t& lane, const BoardModel::Move& move);
+
+	/*! \brief Marks the cells of all sequences in every lane
+	*
+	*	\return A mask with bit n set if lane n contains a sequence
+	*/
+	uint32_t DetectSequences();
+
+	/*! \brief Turns the marked cells of every lane into holes and counts them per lane */
+	void RemoveSequences();
+
+	/*! \brief Lets colors fall into the holes below them in every lane
+	*
+	*	Works on whole rows: every pass moves each color one cell down when there is a hole beneath,
+	*	until no lane changes anymore. Holes end up at the top of their columns.
+	*/
+	void DropColors();
+
+	/*! \brief Fills the holes with new colors drawn from the generator of each lane
+	*
+	*	Colors are drawn column by column from the bottom up, like BoardModel::CompactColors.
+	*
+	*	\param laneMask The lanes to fill, bit n for lane n
+	*/
+	void FillHoles(const uint32_t& laneMask);
+
+	/*! \brief Removes sequences, drops and refills until no lane contains a sequence
+	*
+	*	Starting from the same colors and generator, every lane ends up with the same colors
+	*	as BoardModel::ResolveMove after the swap.
+	*/
+	void ResolveCascades();
+
+	// returns amount of steps of the last cascade of a lane
+	uint16_t GetChainDepth(const uint32_t& lane) const { return m_ChainDepths[lane]; }
+
+	// returns amount of cells cleared by the last cascade of a lane
+	uint32_t GetClearedCells(const uint32_t& lane) const { return m_ClearedCells[lane]; }
+
+	/*! \brief Limits new colors to the first colorCount colors of GemColor
+	*
+	*	\param colorCount Amount of colors between 1 and GemColor::COUNT
+	*/
+	void SetColorCount(const uint8_t& colorCount);
+
+	/*! \brief Replaces the generator of a lane
+	*
+	*	\param lane The board of the batch
+	*	\param randomGenerator The generator that draws the new colors of the lane
+	*/
+	void SetRandomGenerator(const uint32_t& lane, const RandomGenerator& randomGenerator);
+
+	// returns the generator of a lane
+	const RandomGenerator& GetRandomGenerator(const uint32_t& lane) const { return m_RandomGenerators[lane]; }
+
+	// returns the name of the kernels the batch was compiled with
+	static const char* GetKernelName();
+
+	const uint8_t& GetColumns() const { return m_Columns; }
+	const uint8_t& GetRows() const { return m_Rows; }
+
+private:
+	// grid size
+	const uint8_t m_Columns;
+	const uint8_t m_Rows;
+
+	// amount of colors that get drawn
+	uint8_t m_ColorCount;
+
+	// colors of all lanes, cell by cell, LANE_COUNT bytes per cell
+	std::vector<uint8_t> m_Cells;
+	// 0xFF for cells that are part of a sequence, same layout as m_Cells
+	std::vector<uint8_t> m_SequenceFlags;
+	// cells cleared by the current step, one counter per lane
+	std::vector<uint8_t> m_StepCounts;
+
+	std::vector<RandomGenerator> m_RandomGenerators;
+	std::vector<uint16_t> m_ChainDepths;
+	std::vector<uint32_t> m_ClearedCells;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef __BOARD_DELTA_H__
+#define __BOARD_DELTA_H__
+
+#include <cstdint>
+
+/*! A single change of a board cell.
+*	The BoardModel collects all changes of a step in one contiguous list,
+*	so listeners can process them in one pass instead of receiving a callback per cell.
+*/
+struct BoardDelta
+{
+	// kinds of changes
+	enum class Type : uint8_t { ColorAdded, ColorRemoved, ColorDropped, SequenceFound, COUNT };
+
+	// returns the bit of a type in a mask of recorded types
+	static uint32_t MaskOf(const Type& type) { return uint32_t(1) << (uint32_t)type; }
+
+	// mask that contains every type
+	static const uint32_t AllTypes = (uint32_t(1) << (uint32_t)Type::COUNT) - 1;
+
+	Type type;
+	uint16_t column;
+	uint16_t row;
+	// the color that was added, removed, dropped or found
+	uint8_t color;
+};
+
+#endif
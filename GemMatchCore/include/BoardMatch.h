@@ -0,0 +1,24 @@
+#ifndef __BOARD_MATCH_H__
+#define __BOARD_MATCH_H__
+
+#include <cstdint>
+
+/*! A group of connected cells of one color that gets cleared together.
+*	Crossing horizontal and vertical runs form a single match.
+*	The cells of all matches of a board are kept in one contiguous list, each match refers to its part of it.
+*/
+struct BoardMatch
+{
+	// shapes of a match, a run of five or more counts as Line5 even if another run crosses it
+	enum class Shape : uint8_t { Line3, Line4, Line5, L, T, Cross, COUNT };
+
+	Shape shape;
+	uint8_t color;
+	// the cell where crossing runs meet, the middle cell of a single run
+	uint32_t pivotCell;
+	// index of the first cell in the cell list and amount of cells, horizontal runs first
+	uint32_t firstCell;
+	uint32_t cellCount;
+};
+
+#endif
@@ -0,0 +1,561 @@
+#ifndef __BOARDMODEL_H__
+#define __BOARDMODEL_H__
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include "BitBoard.h"
+#include "BoardDelta.h"
+#include "BoardMatch.h"
+#include "RandomGenerator.h"
+
+/*! The underlying representation of the game board.
+*	Notifies the BoardController when there has been a change in its state
+*/
+class BoardModel
+{
+public:
+	/*! \brief The storage used for match detection
+	*
+	*	Scalar scans the color array cell by cell, Bitboard keeps one bit mask per color
+	*	and finds sequences with a few shifts and ANDs. Both raise the same events.
+	*/
+	enum class Backend { Scalar, Bitboard };
+
+	/*! \brief A single gem movement caused by gravity
+	*
+	*	Spawned colors enter the board from above: their source row is negative,
+	*	-1 being the row directly above the top row.
+	*/
+	struct DropMove
+	{
+		uint16_t column;
+		int32_t fromRow;
+		uint16_t toRow;
+		bool isSpawned;
+	};
+
+	/*! \brief A swap of two neighbouring cells, the target is always right of or below the source */
+	struct Move
+	{
+		uint16_t sourceX;
+		uint16_t sourceY;
+		uint16_t targetX;
+		uint16_t targetY;
+	};
+
+	/*! \brief Summary of a move that has been resolved in one call */
+	struct CascadeResult
+	{
+		// false if the swap did not create a sequence and the board is unchanged
+		bool isValid;
+		// amount of cells cleared by each step of the chain
+		std::vector<uint32_t> clearedCells;
+		// colors that entered the board from above, in the order they were drawn
+		std::vector<uint8_t> spawnedColors;
+
+		// returns the amount of steps in the chain
+		size_t GetChainDepth() const { return clearedCells.size(); }
+
+		// returns the cleared cells, the n-th step of the chain counts n times
+		uint32_t GetScore() const
+		{
+			uint32_t score = 0;
+			for (size_t step = 0; step < clearedCells.size(); ++step)
+				score += clearedCells[step] * (uint32_t)(step + 1);
+			return score;
+		}
+	};
+
+	/*! \brief A copy of the state of a board that can be restored later
+	*
+	*	Keeps its storage between saves, so saving and restoring do not allocate once the vector has grown.
+	*/
+	struct Snapshot
+	{
+		std::vector<int> colors;
+		uint32_t holes;
+		uint8_t colorCount;
+		uint64_t hash;
+		RandomGenerator randomGenerator;
+	};
+
+	/*! \brief A position in the journal that the board can be rolled back to */
+	struct JournalMark
+	{
+		// amount of journal entries when the mark was taken
+		size_t length;
+		uint32_t holes;
+		// true if changes were waiting for a detection or detected sequences for their removal
+		bool needsDetection;
+		RandomGenerator randomGenerator;
+	};
+
+	BoardModel(const uint16_t& columns, const uint16_t& rows, const Backend& backend = Backend::Scalar);
+
+	/*! \brief Creates an independent copy of a board, e.g. for a search on another thread
+	*
+	*	Colors, pending changes, color count and random generator are copied.
+	*	Handlers and recorded deltas are not, the copy runs headless.
+	*/
+	BoardModel(const BoardModel& other);
+
+	// size and backend can not change, CopyFrom reloads a board of the same shape
+	BoardModel& operator=(const BoardModel& other) = delete;
+
+	/*! \brief Copies the state of a board with the same size and backend
+	*
+	*	Reuses the storage of this board, so a search can reload a position without allocations.
+	*	Handlers and recorded delta types of this board are kept.
+	*	\return false if the size or the backend differ, the board stays unchanged then
+	*/
+	bool CopyFrom(const BoardModel& other);
+
+	virtual ~BoardModel();
+
+	/*! \brief Empties the board without releasing its memory
+	*
+	*	All cells become holes and pending changes and deltas are dropped.
+	*	Size, backend, handlers, color count and random generator are kept, so a board can be reused for many games.
+	*/
+	void Reset();
+
+	/*! \brief Saves the colors, holes, hash and random generator of the board
+	*
+	*	\param snapshot Receives the state
+	*/
+	void SaveSnapshot(Snapshot& snapshot) const;
+
+	/*! \brief Restores a state saved by SaveSnapshot() with a single copy of the color array
+	*
+	*	Every line gets scanned by the next detection and the journal is cleared.
+	*	Snapshots of boards with another size are ignored.
+	*
+	*	\param snapshot The state to restore
+	*/
+	void RestoreSnapshot(const Snapshot& snapshot);
+
+	/*! \brief Starts or stops recording the previous color of every changed cell
+	*
+	*	Swaps, removals and drops are recorded, so a search can undo them in O(changes) with Rollback().
+	*	Populate, Shuffle, Reset and RestoreSnapshot clear the journal, take a snapshot around them instead.
+	*
+	*	\param isEnabled true to record changes, false stops recording and clears the journal
+	*/
+	void SetJournalEnabled(const bool& isEnabled);
+
+	// returns the current end of the journal
+	JournalMark GetJournalMark() const;
+
+	/*! \brief Undoes all changes recorded after a mark, newest first
+	*
+	*	Sequences detected after the mark are dropped. If the mark was taken with changes waiting for a detection
+	*	or with detected sequences, the next detection scans the whole board, so none of them gets lost.
+	*	Marks behind the end of the journal are ignored.
+	*
+	*	\param mark The mark to return to
+	*/
+	void Rollback(const JournalMark& mark);
+
+	/*! \brief Retrieves the color of a cell
+	*
+	*	\param column The column of the requested cell
+	*	\param row The row of the requested cell 
+	*/
+	const uint8_t GetColor(const uint16_t& column, const uint16_t& row) const;
+
+	/*! \brief Changes the color of a single cell without raising events
+	*
+	*	\param column The column of the cell
+	*	\param row The row of the cell
+	*	\param color The new color or -1 for a hole
+	*/
+	void SetColor(const uint16_t& column, const uint16_t& row, const int& color);
+
+	/*! \brief Swaps the color of the source cell with the color of the target cell
+	*
+	*	\param sourceX Horizontal postion of source cell
+	*	\param sourceY Vertical postion of source cell
+	*	\param targetX Horizontal postion of target cell
+	*	\param targetY Vertical postion of target cell
+	*/
+	bool SwapColors(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY);
+
+	/*! \brief Populates the board with random colors and makes sure that the board does not contain any sequences
+	*
+	*	Each cell is drawn once from the colors that do not complete a sequence, so there are no retries.
+	*	A pattern that can be completed by a single swap is planted first, so the board always has a valid move.
+	*/
+	void Populate();
+
+	/*! \brief Lists every swap that creates a sequence
+	*
+	*	Looks at each pair of neighbouring cells once and checks the precomputed 3-cell patterns
+	*	around both cells without modifying the board.
+	*
+	*	\param moves Receives the valid swaps in row order
+	*/
+	void FindMoves(std::vector<Move>& moves);
+
+	/*! \brief Checks if at least one swap creates a sequence
+	*
+	*	Stops at the first valid swap.
+	*/
+	bool HasMoves();
+
+	/*! \brief Rearranges the colors of the board until it contains no sequence and at least one valid swap
+	*
+	*	Falls back to populating the board again if shuffling does not produce a playable board.
+	*/
+	void Shuffle();
+
+	/*! \brief Detects matching color sequences on the board
+	*
+	*	Only rows and columns that changed since the last call are scanned, columns only within two rows of the changes.
+	*	Sequences of changed rows are reported first, then sequences of changed columns.
+	*/
+	void DetectColorSequences();
+
+	/*! \brief Lists every match on the board with its shape and its cells
+	*
+	*	Each row and each column is scanned once for runs of three or more.
+	*	Crossing runs are joined into one match, and the arms around the crossing cell
+	*	select L, T or Cross from a 16-entry table. The board is not changed and no events are raised.
+	*
+	*	\param matches Receives the matches, horizontal runs first
+	*	\param cells Receives the cell indices of all matches, see BoardMatch::firstCell
+	*/
+	void ClassifyMatches(std::vector<BoardMatch>& matches, std::vector<uint32_t>& cells);
+
+	/*! \brief Detect whether the current board state contains any matching color sequences or not
+	*
+	*/
+	const bool ContainsSequences();
+
+	/*! \brief Removes matching color sequences from the board
+	*
+	*	Only the cells found by the last detection are visited, in row by row order.
+	*/
+	void RemoveSequences();
+
+	/*! \brief Drops colors into holes that are beneath
+	*
+	*	Holes rise like bubbles to the top. When they arrive at the top they get filled with a new random color
+	*/
+	void DropColors();
+
+	/*! \brief Closes all holes at once
+	*
+	*	Settles every column in a single pass: colors fall straight to their final cell
+	*	and the remaining holes at the top get filled with new random colors.
+	*	No handlers are invoked, the caller gets the list of movements instead.
+	*
+	*	\param moves Receives the movements ordered column by column from bottom to top
+	*/
+	void CompactColors(std::vector<DropMove>& moves);
+
+	/*! \brief Plays a move and resolves the whole cascade synchronously
+	*
+	*	Swaps the cells, then removes sequences and compacts the board until no sequence is left.
+	*	Deltas are recorded like in the single steps, the list holds the changes of the last step.
+	*
+	*	\param move The swap to play
+	*	\param result Receives the summary of the chain, its lists are reused
+	*	\return true if the swap was valid
+	*/
+	bool ResolveMove(const Move& move, CascadeResult& result);
+
+	/*! \brief Prints matching color sequences to the consoles
+	*
+	*/
+	void PrintValidSequences();
+
+	/*! \brief Prints the state of the board to the console
+	*
+	*/
+	void Print();
+
+	// returns the amount of columns
+	const uint16_t& GetColumns() const;
+	// returns the amount of rows
+	const uint16_t& GetRows() const;
+	// returns amount of holes
+	const uint32_t& GetHoles();
+
+	/*! \brief Returns the Zobrist hash of the colors of all cells
+	*
+	*	Updated with every changed cell, so swaps, removals and drops cost no extra scan.
+	*	Boards of the same size with the same colors have the same hash, holes do not count.
+	*/
+	const uint64_t& GetHash() const { return m_Hash; }
+
+	/*! \brief Limits new colors to the first colorCount colors of GemColor
+	*
+	*	Takes effect for colors drawn afterwards, so call it before Populate.
+	*	With three colors or less Populate cannot always avoid initial sequences.
+	*
+	*	\param colorCount Amount of colors between 1 and GemColor::COUNT
+	*/
+	void SetColorCount(const uint8_t& colorCount);
+
+	// returns the amount of colors that are drawn
+	const uint8_t& GetColorCount() const { return m_ColorCount; }
+
+	/*! \brief Counts the cells the first step of a move would clear, without changing the board
+	*
+	*	\param move The swap to rate
+	*	\return The amount of cells in the sequences created by the swap, 0 if the swap is invalid
+	*/
+	int CountMoveMatches(const Move& move);
+
+	/*! \brief Restarts the random colors from a seed
+	*
+	*	Two boards with the same dimensions and seed produce the same games.
+	*
+	*	\param seed The seed of the random number generator
+	*/
+	void SetSeed(const uint64_t& seed);
+
+	/*! \brief Replaces the random number generator, e.g. with one stream of RandomGenerator::GetStream()
+	*
+	*	\param randomGenerator The generator to copy
+	*/
+	void SetRandomGenerator(const RandomGenerator& randomGenerator);
+
+	// returns the random number generator that draws new colors
+	const RandomGenerator& GetRandomGenerator() const { return m_RandomNumberGenerator; }
+
+	/*! \brief Selects which kinds of changes get recorded in the delta list
+	*
+	*	Nothing is recorded by default, so headless users do not pay for a list they never read.
+	*
+	*	\param typeMask Combination of BoardDelta::MaskOf() values
+	*/
+	void SetRecordedDeltas(const uint32_t& typeMask);
+
+	/*! \brief Returns the changes made by the last step
+	*
+	*	DetectColorSequences, RemoveSequences, DropColors and CompactColors each start a new list.
+	*/
+	const std::vector<BoardDelta>& GetDeltas() const { return m_Deltas; }
+
+	// registration methods for handlers that are interested in state changes
+	void SetColorAddedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction);
+	void SetColorRemovedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction);
+	void SetColorDroppedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction);
+	void SetSequenceFoundHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction);
+
+private:
+	// grid size
+	const uint16_t m_Columns;
+	const uint16_t m_Rows;
+
+	// array that holds the color information of each board cell
+	int* m_Colors;
+
+	// amount of holes in board
+	uint32_t m_Holes;
+
+	// amount of colors that get drawn
+	uint8_t m_ColorCount;
+
+	// storage used for match detection
+	const Backend m_Backend;
+
+	// Zobrist hash of the color array
+	uint64_t m_Hash;
+
+	const uint8_t GetRandomColor();
+
+	/*! \brief Changes the color of a cell and keeps the color masks up to date
+	*
+	*	\param position The index of the cell
+	*	\param color The new color or -1 for a hole
+	*/
+	void SetCellColor(const int& position, const int& color);
+
+	/*! \brief Exchanges the colors of two cells in the color array and the color masks only
+	*
+	*	Hash, dirty lines and journal are left alone, so a trial swap can be undone without a trace.
+	*/
+	void ExchangeCellColors(const int& sourcePosition, const int& targetPosition);
+
+	/*! \brief Recreates all color masks from the color array */
+	void RebuildColorMasks();
+
+	/*! \brief Returns the random key of a color on a cell
+	*
+	*	\param position The index of the cell
+	*	\param color The color or -1 for a hole
+	*/
+	static uint64_t GetZobristKey(const int& position, const int& color);
+
+	/*! \brief Recomputes the hash from the color array after the cells have been written directly */
+	void RebuildHash();
+
+	/*! \brief Remembers that the row and the column of a cell have changed
+	*
+	*	\param position The index of the cell
+	*/
+	void MarkDirty(const int& position);
+
+	/*! \brief Marks every row and column as changed */
+	void MarkAllDirty();
+
+	/*! \brief Forgets all changed rows and columns */
+	void ClearDirtyLines();
+
+	/*! \brief Checks if the color of the cell is part of a sequence
+	*/
+	bool IsPartOfSequence(const uint16_t& cellX, const uint16_t& cellY);
+
+	/*! \brief Records a change and invokes the matching handler, if there is one
+	*
+	*	\param type The kind of change
+	*	\param column The column of the changed cell
+	*	\param row The row of the changed cell
+	*	\param color The color involved in the change
+	*/
+	void Notify(const BoardDelta::Type& type, const uint16_t& column, const uint16_t& row, const int& color);
+
+	/*! \brief Checks if a color placed on a cell by a swap completes one of the patterns
+	*
+	*	\param cellX Horizontal postion of the cell the color lands on
+	*	\param cellY Vertical postion of the cell the color lands on
+	*	\param color The color that lands on the cell
+	*	\param patterns The pattern table of the swap direction and side
+	*/
+	bool CompletesPattern(const int& cellX, const int& cellY, const int& color, const int (*patterns)[4]);
+
+	/*! \brief Checks if swapping a cell with its right or lower neighbour creates a sequence
+	*
+	*	\param position The index of the source cell
+	*	\param direction 0 for the right neighbour, 1 for the lower neighbour
+	*/
+	bool IsValidMove(const int& position, const int& direction);
+
+	/*! \brief Places three cells of the same color that form a sequence after one swap
+	*
+	*	Used by Populate on an empty board, the pattern is placed at a random position and orientation.
+	*/
+	void PlantMove();
+
+	/*! \brief Checks if a color would be part of a sequence with the colored cells around it
+	*
+	*	\param position The index of the cell
+	*	\param color The color to check
+	*/
+	bool CompletesSequence(const int& position, const int& color);
+
+	/*! \brief Checks if a color would complete a sequence with the two cells to the left or the two cells above
+	*
+	*	\param position The index of the cell
+	*	\param color The color to check
+	*/
+	bool CompletesEarlierSequence(const int& position, const int& color);
+
+	/*! \brief Counts the cells of the horizontal and vertical sequences through a cell
+	*
+	*	\param cellX Horizontal postion of the cell
+	*	\param cellY Vertical postion of the cell
+	*	\return The amount of cells in sequences, including the cell itself, or 0 if there is none
+	*/
+	int CountSequenceCells(const int& cellX, const int& cellY);
+
+	/*! \brief Returns the run a match is made of, joined runs share the run with the lowest index
+	*
+	*	\param runIndex The index of a run in m_MatchRuns
+	*/
+	uint32_t FindMatchRun(const uint32_t& runIndex);
+
+	/*! \brief Checks if any cell of the board is part of a sequence */
+	bool ContainsAnySequence();
+
+	/*! \brief Bitboard version of DetectColorSequences
+	*
+	*	\param firstRow The first row a new sequence can have cells in
+	*	\param lastRow The last row a new sequence can have cells in
+	*/
+	void DetectColorSequencesBitboard(const int& firstRow, const int& lastRow);
+
+	/*! \brief Marks a cell as part of a sequence and remembers it for RemoveSequences()
+	*
+	*	\param position The index of the cell
+	*/
+	void MarkSequenceCell(const int& position);
+
+	/*! Unmarks the cells of all detected sequences */
+	void ClearSequences();
+
+	/*! \brief Bitboard version of IsPartOfSequence */
+	bool IsPartOfSequenceBitboard(const uint16_t& cellX, const uint16_t& cellY);
+
+	// a bit array that describes valid color sequences on the board
+	std::vector<bool> m_ColorSequences;
+	// the cells that are marked in m_ColorSequences or m_SequenceMask, so removing them does not visit the whole board
+	std::vector<uint32_t> m_SequenceCells;
+
+	// flags and lists of the rows and columns that changed since the last detection
+	std::vector<bool> m_IsRowDirty;
+	std::vector<bool> m_IsColumnDirty;
+	std::vector<uint16_t> m_DirtyRows;
+	std::vector<uint16_t> m_DirtyColumns;
+
+	// bitboard backend: one mask per color, a bit is set if the cell has that color
+	std::vector<BitBoard> m_ColorMasks;
+	// bitboard backend: cells that are part of a valid color sequence
+	BitBoard m_SequenceMask;
+	// bitboard backend: cells that are far enough from the right edge to start a horizontal sequence
+	BitBoard m_HorizontalStartMask;
+	// bitboard backend: scratch masks for the first cells and all cells of horizontal and vertical sequences
+	BitBoard m_HorizontalStarts;
+	BitBoard m_VerticalStarts;
+	BitBoard m_HorizontalRuns;
+	BitBoard m_VerticalRuns;
+	BitBoard m_ScratchMask;
+
+	// small state engine for random number generation
+	RandomGenerator m_RandomNumberGenerator;
+
+	// drop movements of ResolveMove, kept to avoid allocations
+	std::vector<DropMove> m_CascadeMoves;
+
+	// changes made by the last step and the kinds of changes that get recorded
+	std::vector<BoardDelta> m_Deltas;
+	uint32_t m_RecordedDeltaTypes;
+
+	// a horizontal or vertical run of ClassifyMatches
+	struct MatchRun
+	{
+		uint32_t startCell;
+		uint16_t length;
+		// 1 for horizontal runs, the amount of columns for vertical runs
+		uint16_t step;
+		// the run this run has been joined with
+		uint32_t parent;
+		// bits of the arms around the crossing cell and the crossing cell, if a run crosses this one
+		uint8_t arms;
+		uint32_t crossingCell;
+		// the match of the run, only valid for the run a match is made of
+		uint32_t matchIndex;
+	};
+
+	// scratch lists of ClassifyMatches: the runs and the horizontal run each cell belongs to
+	std::vector<MatchRun> m_MatchRuns;
+	std::vector<int32_t> m_HorizontalRunIds;
+
+	// a changed cell and its color before the change
+	struct JournalEntry
+	{
+		uint32_t position;
+		int32_t color;
+	};
+
+	// changes recorded since the journal was enabled or cleared
+	std::vector<JournalEntry> m_Journal;
+	bool m_IsJournalEnabled;
+
+	// handler functions, one per kind of change
+	std::function <void(const uint16_t&, const uint16_t&)> m_Handlers[(size_t)BoardDelta::Type::COUNT];
+};
+#endif
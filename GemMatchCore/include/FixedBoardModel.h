@@ -0,0 +1,321 @@
+#ifndef __FIXED_BOARD_MODEL_H__
+#define __FIXED_BOARD_MODEL_H__
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "GemColor.h"
+#include "BoardModel.h"
+#include "RandomGenerator.h"
+
+/*! A board whose size is known at compile time.
+*	Every index and loop bound is a constant, so the compiler can unroll and vectorize
+*	the scans of detection and gravity. Resolves moves exactly like BoardModel::ResolveMove,
+*	but raises no events. Use BoardModel for sizes that are only known at runtime.
+*/
+template <uint8_t Columns, uint8_t Rows>
+class FixedBoardModel
+{
+public:
+	static const uint8_t COLUMNS = Columns;
+	static const uint8_t ROWS = Rows;
+	static const int CELL_COUNT = Columns * Rows;
+
+	FixedBoardModel() :
+	m_ColorCount((uint8_t)GemColor::COUNT)
+	{
+		std::fill(m_Colors, m_Colors + CELL_COUNT, (int8_t)-1);
+		std::fill(m_Sequences, m_Sequences + CELL_COUNT, (uint8_t)0);
+	}
+
+	virtual ~FixedBoardModel()
+	{
+	}
+
+	/*! \brief Copies the colors, the color count and the random generator of a board of the same size
+	*
+	*	\param board The board to copy
+	*	\return false if the size of the board differs, nothing is copied then
+	*/
+	bool Load(const BoardModel& board)
+	{
+		if (board.GetColumns() != Columns || board.GetRows() != Rows)
+			return false;
+
+		for (int y = 0; y < Rows; ++y)
+		{
+			for (int x = 0; x < Columns; ++x)
+				m_Colors[y * Columns + x] = (int8_t)board.GetColor(x, y);
+		}
+
+		m_ColorCount = board.GetColorCount();
+		m_RandomNumberGenerator = board.GetRandomGenerator();
+		return true;
+	}
+
+	/*! \brief Copies the state of another board, matches BoardModel::CopyFrom
+	*
+	*	\return Always true, both boards have the same size
+	*/
+	bool CopyFrom(const FixedBoardModel& other)
+	{
+		*this = other;
+		return true;
+	}
+
+	/*! \brief Retrieves the color of a cell
+	*
+	*	\return The color, 255 for a hole and 0 outside the board
+	*/
+	uint8_t GetColor(const uint16_t& column, const uint16_t& row) const
+	{
+		if (column >= Columns || row >= Rows)
+			return 0;
+
+		return (uint8_t)m_Colors[row * Columns + column];
+	}
+
+	/*! \brief Changes the color of a cell
+	*
+	*	\param color The new color or -1 for a hole
+	*/
+	void SetColor(const uint16_t& column, const uint16_t& row, const int& color)
+	{
+		m_Colors[row * Columns + column] = (int8_t)color;
+	}
+
+	/*! \brief Swaps two cells, the swap is reverted if neither cell becomes part of a sequence
+	*
+	*	\return true if the swap has been kept
+	*/
+	bool SwapColors(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY)
+	{
+		if (sourceX >= Columns || sourceY >= Rows || targetX >= Columns || targetY >= Rows)
+			return false;
+
+		std::swap(m_Colors[sourceY * Columns + sourceX], m_Colors[targetY * Columns + targetX]);
+
+		if (IsPartOfSequence(sourceX, sourceY) || IsPartOfSequence(targetX, targetY))
+			return true;
+
+		std::swap(m_Colors[sourceY * Columns + sourceX], m_Colors[targetY * Columns + targetX]);
+		return false;
+	}
+
+	/*! \brief Lists every swap that creates a sequence
+	*
+	*	\param moves Receives the valid swaps in row order
+	*/
+	void FindMoves(std::vector<BoardModel::Move>& moves)
+	{
+		moves.clear();
+
+		for (int y = 0; y < Rows; ++y)
+		{
+			for (int x = 0; x < Columns; ++x)
+			{
+				// swap with the right and the lower neighbour, then swap back
+				if (x < Columns - 1 && IsValidSwap(x, y, x + 1, y))
+				{
+					BoardModel::Move move = { (uint16_t)x, (uint16_t)y, (uint16_t)(x + 1), (uint16_t)y };
+					moves.push_back(move);
+				}
+
+				if (y < Rows - 1 && IsValidSwap(x, y, x, y + 1))
+				{
+					BoardModel::Move move = { (uint16_t)x, (uint16_t)y, (uint16_t)x, (uint16_t)(y + 1) };
+					moves.push_back(move);
+				}
+			}
+		}
+	}
+
+	/*! \brief Marks the cells of all sequences of the whole board
+	*
+	*	\return true if the board contains at least one sequence
+	*/
+	bool DetectColorSequences()
+	{
+		uint8_t found = 0;
+
+		for (int i = 0; i < CELL_COUNT; ++i)
+			m_Sequences[i] = 0;
+
+		// horizontal runs of three, longer runs are marked by overlapping starts
+		for (int y = 0; y < Rows; ++y)
+		{
+			for (int x = 0; x < Columns - 2; ++x)
+			{
+				int i = y * Columns + x;
+				uint8_t isRun = m_Colors[i] >= 0 && m_Colors[i] == m_Colors[i + 1] && m_Colors[i] == m_Colors[i + 2];
+
+				m_Sequences[i] |= isRun;
+				m_Sequences[i + 1] |= isRun;
+				m_Sequences[i + 2] |= isRun;
+				found |= isRun;
+			}
+		}
+
+		// vertical runs of three
+		for (int i = 0; i < (Rows - 2) * Columns; ++i)
+		{
+			uint8_t isRun = m_Colors[i] >= 0 && m_Colors[i] == m_Colors[i + Columns] && m_Colors[i] == m_Colors[i + 2 * Columns];
+
+			m_Sequences[i] |= isRun;
+			m_Sequences[i + Columns] |= isRun;
+			m_Sequences[i + 2 * Columns] |= isRun;
+			found |= isRun;
+		}
+
+		return found != 0;
+	}
+
+	/*! \brief Turns the cells marked by DetectColorSequences into holes
+	*
+	*	\return The amount of cleared cells
+	*/
+	uint16_t RemoveSequences()
+	{
+		uint16_t clearedCells = 0;
+
+		for (int i = 0; i < CELL_COUNT; ++i)
+		{
+			clearedCells += m_Sequences[i];
+			m_Colors[i] = m_Sequences[i] ? (int8_t)-1 : m_Colors[i];
+		}
+
+		return clearedCells;
+	}
+
+	/*! \brief Closes all holes at once and fills the top with new colors
+	*
+	*	Draws the new colors in the same order as BoardModel::CompactColors.
+	*/
+	void CompactColors()
+	{
+		for (int x = 0; x < Columns; ++x)
+		{
+			int targetRow = Rows - 1;
+
+			for (int y = Rows - 1; y >= 0; --y)
+			{
+				int8_t color = m_Colors[y * Columns + x];
+
+				if (color >= 0)
+				{
+					m_Colors[targetRow * Columns + x] = color;
+					--targetRow;
+				}
+			}
+
+			for (int y = targetRow; y >= 0; --y)
+				m_Colors[y * Columns + x] = (int8_t)m_RandomNumberGenerator.NextBounded(m_ColorCount);
+		}
+	}
+
+	/*! \brief Plays a move and resolves the whole cascade
+	*
+	*	\param move The swap to play
+	*	\param result Receives the summary of the chain, its lists are reused
+	*	\return true if the swap was valid
+	*/
+	bool ResolveMove(const BoardModel::Move& move, BoardModel::CascadeResult& result)
+	{
+		result.clearedCells.clear();
+		result.spawnedColors.clear();
+
+		result.isValid = SwapColors(move.sourceX, move.sourceY, move.targetX, move.targetY);
+
+		if (result.isValid == false)
+			return false;
+
+		while (DetectColorSequences())
+		{
+			result.clearedCells.push_back(RemoveSequences());
+			CompactColors();
+		}
+
+		return true;
+	}
+
+	/*! \brief Limits new colors to the first colorCount colors of GemColor */
+	void SetColorCount(const uint8_t& colorCount)
+	{
+		m_ColorCount = std::max<uint8_t>(1, std::min<uint8_t>(colorCount, (uint8_t)GemColor::COUNT));
+	}
+
+	/*! \brief Replaces the generator that draws new colors */
+	void SetRandomGenerator(const RandomGenerator& randomGenerator) { m_RandomNumberGenerator = randomGenerator; }
+
+	// returns the generator that draws new colors
+	const RandomGenerator& GetRandomGenerator() const { return m_RandomNumberGenerator; }
+
+private:
+	/*! \brief Checks if the color of the cell is part of a horizontal or vertical run of three */
+	bool IsPartOfSequence(const int& cellX, const int& cellY) const
+	{
+		int8_t color = m_Colors[cellY * Columns + cellX];
+
+		// holes never form a sequence
+		if (color < 0)
+			return false;
+
+		int left = cellX;
+		while (left > 0 && m_Colors[cellY * Columns + left - 1] == color)
+			--left;
+		int right = cellX;
+		while (right < Columns - 1 && m_Colors[cellY * Columns + right + 1] == color)
+			++right;
+
+		if (right - left >= 2)
+			return true;
+
+		int top = cellY;
+		while (top > 0 && m_Colors[(top - 1) * Columns + cellX] == color)
+			--top;
+		int bottom = cellY;
+		while (bottom < Rows - 1 && m_Colors[(bottom + 1) * Columns + cellX] == color)
+			++bottom;
+
+		return bottom - top >= 2;
+	}
+
+	/*! \brief Checks if swapping two cells creates a sequence, the board is unchanged afterwards */
+	bool IsValidSwap(const int& sourceX, const int& sourceY, const int& targetX, const int& targetY)
+	{
+		int8_t& source = m_Colors[sourceY * Columns + sourceX];
+		int8_t& target = m_Colors[targetY * Columns + targetX];
+
+		// swapping equal colors changes nothing
+		if (source == target)
+			return false;
+
+		std::swap(source, target);
+		bool isValid = IsPartOfSequence(sourceX, sourceY) || IsPartOfSequence(targetX, targetY);
+		std::swap(source, target);
+
+		return isValid;
+	}
+
+	// colors of all cells row by row, -1 for holes
+	int8_t m_Colors[CELL_COUNT];
+	// 1 for cells that are part of a sequence
+	uint8_t m_Sequences[CELL_COUNT];
+
+	// amount of colors that get drawn
+	uint8_t m_ColorCount;
+
+	RandomGenerator m_RandomNumberGenerator;
+};
+
+template <uint8_t Columns, uint8_t Rows>
+const uint8_t FixedBoardModel<Columns, Rows>::COLUMNS;
+template <uint8_t Columns, uint8_t Rows>
+const uint8_t FixedBoardModel<Columns, Rows>::ROWS;
+template <uint8_t Columns, uint8_t Rows>
+const int FixedBoardModel<Columns, Rows>::CELL_COUNT;
+
+// the size of the board of the game
+typedef FixedBoardModel<8, 8> FixedBoardModel8x8;
+
+#endif
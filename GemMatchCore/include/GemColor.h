@@ -0,0 +1,9 @@
+#ifndef __GEM_COLOR_H__
+#define __GEM_COLOR_H__
+
+/*! The colors a board cell can hold.
+*	Kept apart from the Gem class, so the board logic does not depend on sprites or SDL.
+*/
+enum class GemColor { Red, Green, Blue, Purple, Yellow, COUNT, NONE };
+
+#endif
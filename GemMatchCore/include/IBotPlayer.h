@@ -0,0 +1,24 @@
+#ifndef __IBOT_PLAYER_H__
+#define __IBOT_PLAYER_H__
+
+#include "BoardModel.h"
+
+/*! Interface for players that pick their swaps without user input
+*
+*/
+class IBotPlayer
+{
+public:
+	virtual ~IBotPlayer() {}
+
+	/*! \brief Picks the next swap
+	*
+	*	May take a while and gets called off the main thread, so it must only work on its own copies of the board.
+	*
+	*	\param board The board to play on
+	*	\param move Receives the chosen swap
+	*	\return false if the board has no valid swap
+	*/
+	virtual bool ChooseMove(const BoardModel& board, BoardModel::Move& move) = 0;
+};
+#endif
@@ -0,0 +1,167 @@
+#ifndef __MONTE_CARLO_BOT_H__
+#define __MONTE_CARLO_BOT_H__
+
+#include <cstdint>
+#include <vector>
+#include <chrono>
+#include "BoardModel.h"
+#include "IBotPlayer.h"
+#include "RandomGenerator.h"
+
+/*! A bot that picks its swaps with Monte Carlo Tree Search.
+*	Every iteration replays the swaps of the tree on a copy of the board with new random refills,
+*	so a node stands for a sequence of swaps rather than for a board, and then plays random swaps to the horizon.
+*	Each thread grows a private tree from the same root, the visits of the root swaps are added up at the deadline.
+*	8x8 boards are played on a FixedBoardModel, which resolves the rollouts a lot faster.
+*/
+class MonteCarloBot : public IBotPlayer
+{
+public:
+	MonteCarloBot();
+	virtual ~MonteCarloBot();
+
+	/*! \brief Picks the swap that has been visited most by all threads
+	*
+	*	\param board The board to play on, it is copied
+	*	\param move Receives the chosen swap
+	*	\return false if the board has no valid swap
+	*/
+	virtual bool ChooseMove(const BoardModel& board, BoardModel::Move& move) override;
+
+	/*! \brief Limits the time a single move may take
+	*
+	*	\param milliseconds The time budget, 0 only stops at the iteration limit
+	*/
+	void SetTimeBudget(const uint32_t& milliseconds) { m_TimeBudget = milliseconds; }
+
+	/*! \brief Limits the amount of iterations of each thread
+	*
+	*	Together with a seed and no time budget, the chosen swaps are reproducible.
+	*
+	*	\param iterations The amount of iterations, 0 only stops at the time budget
+	*/
+	void SetIterationLimit(const uint32_t& iterations) { m_IterationLimit = iterations; }
+
+	/*! \brief Sets the amount of swaps each iteration plays, inside the tree and in the rollout after it
+	*
+	*	\param horizon The amount of swaps, at least 1
+	*/
+	void SetHorizon(const uint32_t& horizon);
+
+	/*! \brief Sets the weight of rarely visited swaps in the selection
+	*
+	*	\param exploration The factor of the UCB1 exploration term, relative to the average score
+	*/
+	void SetExploration(const double& exploration) { m_Exploration = exploration; }
+
+	/*! \brief Sets the amount of threads that grow a tree
+	*
+	*	\param threadCount The amount of threads, 0 uses one per hardware thread
+	*/
+	void SetThreadCount(const uint32_t& threadCount);
+
+	/*! \brief Restarts the random refills and rollouts from a seed
+	*
+	*	\param seed The seed of the random number generator
+	*/
+	void SetSeed(const uint64_t& seed) { m_RandomGenerator.Seed(seed); }
+
+	// returns the amount of iterations of all threads for the last move
+	const uint64_t& GetIterationCount() const { return m_IterationCount; }
+
+private:
+	/*! A swap of the tree and its statistics */
+	struct Node
+	{
+		// a node that has not been visited yet
+		Node(const uint32_t& moveKey);
+
+		// the swap that leads to the node, see GetMoveKey()
+		uint32_t moveKey;
+		// amount of iterations that played the swap
+		uint32_t visits;
+		// sum of the scores of these iterations, from the root to the horizon
+		uint64_t totalScore;
+		// indices of the nodes of the swaps that have been tried after this one
+		std::vector<uint32_t> children;
+	};
+
+	/*! The private state of a single thread */
+	struct Tree
+	{
+		// the root is at index 0
+		std::vector<Node> nodes;
+		// nodes visited by the current iteration
+		std::vector<uint32_t> path;
+		// the valid swaps of the current board
+		std::vector<BoardModel::Move> moves;
+		// summary of the last resolved swap
+		BoardModel::CascadeResult result;
+		// draws the refill seeds and the swaps of the rollouts
+		RandomGenerator randomGenerator;
+		// amount of finished iterations
+		uint64_t iterations;
+	};
+
+	/*! \brief Grows a tree until the time budget or the iteration limit is reached
+	*
+	*	Board is BoardModel or a FixedBoardModel, both resolve swaps the same way.
+	*	Without time budget and iteration limit a single iteration is run.
+	*
+	*	\param root The board to search, it is copied for each iteration
+	*	\param tree The tree of the thread
+	*/
+	template <class Board>
+	void GrowTree(const Board& root, Tree& tree);
+
+	/*! \brief Runs GrowTree on all threads and adds up the visits of the root swaps
+	*
+	*	\param root The board to search
+	*	\param rootMoves The valid swaps of the board
+	*	\param move Receives the most visited swap
+	*/
+	template <class Board>
+	void Search(const Board& root, const std::vector<BoardModel::Move>& rootMoves, BoardModel::Move& move);
+
+	/*! \brief Selects the child of a node to follow among the valid swaps of the board
+	*
+	*	A swap that has not been tried yet gets a new child and is taken first, otherwise UCB1 decides.
+	*
+	*	\param tree The tree of the thread, tree.moves holds the valid swaps
+	*	\param nodeIndex The node the board is at
+	*	\param move Receives the chosen swap
+	*	\return The index of the child node
+	*/
+	uint32_t SelectChild(Tree& tree, const uint32_t& nodeIndex, BoardModel::Move& move);
+
+	/*! \brief Returns a number that identifies a swap, the index of the source cell and the direction
+	*
+	*	\param move The swap
+	*	\param columns The amount of columns of the board
+	*/
+	static uint32_t GetMoveKey(const BoardModel::Move& move, const uint16_t& columns);
+
+	// search settings
+	uint32_t m_TimeBudget;
+	uint32_t m_IterationLimit;
+	uint32_t m_Horizon;
+	double m_Exploration;
+	uint32_t m_ThreadCount;
+
+	// the width of the board of the current search
+	uint16_t m_Columns;
+
+	// amount of iterations of all threads for the last move
+	uint64_t m_IterationCount;
+
+	// seeds the trees of each search
+	RandomGenerator m_RandomGenerator;
+
+	// trees of the threads of the current search
+	std::vector<Tree> m_Trees;
+
+	// end of the time budget of the current move
+	std::chrono::steady_clock::time_point m_Deadline;
+};
+
+#endif
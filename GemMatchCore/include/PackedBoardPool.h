@@ -0,0 +1,180 @@
+#ifndef __PACKED_BOARD_POOL_H__
+#define __PACKED_BOARD_POOL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BoardModel;
+
+/*! Many boards of the same size with 4 bits per cell.
+*	The lower 3 bits hold the color, 7 meaning a hole, the upper bit flags a cell that is part of a sequence.
+*	A board of 8x8 cells takes 32 bytes, so a million boards fit into 32 MB.
+*	Boards are addressed by index, GetColor and SwapColors behave like the ones of BoardModel.
+*/
+class PackedBoardPool
+{
+public:
+	/*! \brief Creates an empty pool
+	*
+	*	\param columns Width of every board
+	*	\param rows Height of every board
+	*	\param capacity Amount of boards to reserve memory for
+	*/
+	PackedBoardPool(const uint8_t& columns, const uint8_t& rows, const size_t& capacity = 0);
+	virtual ~PackedBoardPool();
+
+	/*! \brief Adds a board that consists of holes only
+	*
+	*	Boards that have been freed are reused first.
+	*
+	*	\return The index of the board
+	*/
+	uint32_t Allocate();
+
+	/*! \brief Gives the memory of a board back to the pool
+	*
+	*	\param board The index of the board, it may be returned by a later Allocate()
+	*/
+	void Free(const uint32_t& board);
+
+	/*! \brief Retrieves the color of a cell
+	*
+	*	\param board The index of the board
+	*	\param column The column of the requested cell
+	*	\param row The row of the requested cell
+	*	\return The color, 255 for a hole and 0 outside the board
+	*/
+	uint8_t GetColor(const uint32_t& board, const uint8_t& column, const uint8_t& row) const
+	{
+		if (column >= m_Columns || row >= m_Rows)
+			return 0;
+
+		uint8_t color = GetCell(board, row * m_Columns + column) & COLOR_BITS;
+		return color == HOLE ? 255 : color;
+	}
+
+	/*! \brief Changes the color of a cell and clears its sequence flag
+	*
+	*	\param board The index of the board
+	*	\param column The column of the cell
+	*	\param row The row of the cell
+	*	\param color The new color or -1 for a hole
+	*/
+	void SetColor(const uint32_t& board, const uint8_t& column, const uint8_t& row, const int& color)
+	{
+		SetCell(board, row * m_Columns + column, color < 0 ? HOLE : (uint8_t)color);
+	}
+
+	/*! \brief Swaps the color of the source cell with the color of the target cell
+	*
+	*	The swap is reverted if neither cell becomes part of a sequence.
+	*
+	*	\param board The index of the board
+	*	\param sourceX Horizontal postion of source cell
+	*	\param sourceY Vertical postion of source cell
+	*	\param targetX Horizontal postion of target cell
+	*	\param targetY Vertical postion of target cell
+	*	\return true if the swap has been kept
+	*/
+	bool SwapColors(const uint32_t& board, const uint8_t& sourceX, const uint8_t& sourceY, const uint8_t& targetX, const uint8_t& targetY);
+
+	/*! \brief Flags the cells of all sequences of a board
+	*
+	*	\param board The index of the board
+	*	\return true if the board contains at least one sequence
+	*/
+	bool DetectColorSequences(const uint32_t& board);
+
+	/*! \brief Checks the sequence flag set by DetectColorSequences
+	*
+	*	\param board The index of the board
+	*	\param column The column of the cell
+	*	\param row The row of the cell
+	*/
+	bool IsSequence(const uint32_t& board, const uint8_t& column, const uint8_t& row) const
+	{
+		return (GetCell(board, row * m_Columns + column) & SEQUENCE_BIT) != 0;
+	}
+
+	/*! \brief Packs the colors of a board model into a board of the pool
+	*
+	*	\param board The index of the board
+	*	\param model A board model of the same size
+	*/
+	void Store(const uint32_t& board, BoardModel& model);
+
+	/*! \brief Unpacks the colors of a board of the pool into a board model
+	*
+	*	\param board The index of the board
+	*	\param model A board model of the same size
+	*/
+	void Load(const uint32_t& board, BoardModel& model) const;
+
+	/*! \brief Copies all cells of a board to another board of the pool
+	*
+	*	\param source The index of the board to copy
+	*	\param target The index of the board to overwrite
+	*/
+	void Copy(const uint32_t& source, const uint32_t& target);
+
+	// returns amount of boards that are in use
+	size_t GetSize() const { return m_BoardCount - m_FreeBoards.size(); }
+
+	// returns the memory taken by a single board
+	size_t GetBytesPerBoard() const { return m_WordsPerBoard * sizeof(uint64_t); }
+
+	const uint8_t& GetColumns() const { return m_Columns; }
+	const uint8_t& GetRows() const { return m_Rows; }
+
+private:
+	// bits of a cell that hold the color
+	static const uint8_t COLOR_BITS = 0x7;
+	// color value of a hole
+	static const uint8_t HOLE = 0x7;
+	// bit of a cell that flags a sequence
+	static const uint8_t SEQUENCE_BIT = 0x8;
+	// amount of cells in a 64 bit word
+	static const uint32_t CELLS_PER_WORD = 16;
+
+	// returns all 4 bits of a cell
+	uint8_t GetCell(const uint32_t& board, const uint32_t& cell) const
+	{
+		return (m_Words[board * m_WordsPerBoard + cell / CELLS_PER_WORD] >> ((cell % CELLS_PER_WORD) * 4)) & 0xF;
+	}
+
+	// replaces all 4 bits of a cell
+	void SetCell(const uint32_t& board, const uint32_t& cell, const uint8_t& value)
+	{
+		uint64_t& word = m_Words[board * m_WordsPerBoard + cell / CELLS_PER_WORD];
+		uint32_t shift = (cell % CELLS_PER_WORD) * 4;
+
+		word = (word & ~(uint64_t(0xF) << shift)) | (uint64_t(value) << shift);
+	}
+
+	/*! \brief Checks if the color of the cell is part of a sequence
+	*
+	*	\param board The index of the board
+	*	\param cellX Horizontal postion of the cell
+	*	\param cellY Vertical postion of the cell
+	*/
+	bool IsPartOfSequence(const uint32_t& board, const int& cellX, const int& cellY) const;
+
+	// grid size
+	const uint8_t m_Columns;
+	const uint8_t m_Rows;
+
+	// amount of words each board takes
+	const uint32_t m_WordsPerBoard;
+
+	// cells of all boards, board after board
+	std::vector<uint64_t> m_Words;
+
+	// amount of boards that have been allocated, including freed ones
+	uint32_t m_BoardCount;
+
+	// freed boards waiting to be reused
+	std::vector<uint32_t> m_FreeBoards;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __RANDOM_GENERATOR_H__
+#define __RANDOM_GENERATOR_H__
+
+#include <cstdint>
+
+/*! Small and fast pseudo random number generator (xoshiro128**).
+*	The whole state fits into 16 bytes, so every board can carry its own generator.
+*	The same seed always produces the same sequence, and Jump() splits a seed
+*	into 2^64 non-overlapping streams, e.g. one per thread.
+*	Unlike the standard distributions, the helpers produce the same numbers with every compiler.
+*/
+class RandomGenerator
+{
+public:
+	RandomGenerator();
+	explicit RandomGenerator(const uint64_t& seed);
+
+	/*! \brief Restarts the sequence from a seed
+	*
+	*	\param seed Any value, including 0
+	*/
+	void Seed(const uint64_t& seed);
+
+	/*! Returns the next 32 random bits */
+	uint32_t Next()
+	{
+		const uint32_t result = RotateLeft(m_State[1] * 5, 7) * 9;
+		const uint32_t t = m_State[1] << 9;
+
+		m_State[2] ^= m_State[0];
+		m_State[3] ^= m_State[1];
+		m_State[1] ^= m_State[2];
+		m_State[0] ^= m_State[3];
+		m_State[2] ^= t;
+		m_State[3] = RotateLeft(m_State[3], 11);
+
+		return result;
+	}
+
+	/*! \brief Returns a random number in [0, bound) with a single draw
+	*
+	*	Maps the 32 random bits onto the range with a multiplication instead of a modulo.
+	*	The bias is at most bound / 2^32, which is negligible for the small ranges of a board.
+	*/
+	uint32_t NextBounded(const uint32_t& bound)
+	{
+		return (uint32_t)(((uint64_t)Next() * bound) >> 32);
+	}
+
+	/*! Advances the generator by 2^64 draws, the start of the next independent stream */
+	void Jump();
+
+	/*! \brief Returns a generator for one of the independent streams of this generator
+	*
+	*	Stream 0 continues this generator, stream n starts n jumps later.
+	*
+	*	\param streamIndex The index of the stream, e.g. the index of a thread
+	*/
+	RandomGenerator GetStream(const uint32_t& streamIndex) const;
+
+private:
+	static uint32_t RotateLeft(const uint32_t& value, const int& count)
+	{
+		return (value << count) | (value >> (32 - count));
+	}
+
+	uint32_t m_State[4];
+};
+
+#endif
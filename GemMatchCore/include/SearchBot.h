@@ -0,0 +1,148 @@
+#ifndef __SEARCH_BOT_H__
+#define __SEARCH_BOT_H__
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include "BoardModel.h"
+#include "IBotPlayer.h"
+#include "RandomGenerator.h"
+#include "TranspositionTable.h"
+
+/*! A bot that looks several moves ahead with an expectimax search.
+*	The colors that refill the board are unknown, so every swap is a chance node:
+*	it gets resolved several times with different random refills, rolled back with the journal each time, and the results are averaged.
+*	Below the root only the most promising swaps are followed (beam search), ranked by the cells their first step clears.
+*	The swaps of the root are shared by several threads, the search deepens one move at a time until the time budget runs out.
+*/
+class SearchBot : public IBotPlayer
+{
+public:
+	SearchBot();
+	virtual ~SearchBot();
+
+	/*! \brief Picks the swap with the best expected score
+	*
+	*	Always completes a search of depth one, deeper searches are only used if they finish in time.
+	*
+	*	\param board The board to play on, it is copied
+	*	\param move Receives the chosen swap
+	*	\return false if the board has no valid swap
+	*/
+	virtual bool ChooseMove(const BoardModel& board, BoardModel::Move& move) override;
+
+	/*! \brief Limits the time a single move may take
+	*
+	*	\param milliseconds The time budget, 0 searches to the maximum depth regardless of time
+	*/
+	void SetTimeBudget(const uint32_t& milliseconds) { m_TimeBudget = milliseconds; }
+
+	/*! \brief Limits the amount of moves to look ahead
+	*
+	*	\param maxDepth The maximum depth, at least 1
+	*/
+	void SetMaxDepth(const uint8_t& maxDepth);
+
+	/*! \brief Sets the amount of swaps that get followed below the root
+	*
+	*	\param beamWidth The amount of swaps, 0 follows all of them
+	*/
+	void SetBeamWidth(const uint32_t& beamWidth) { m_BeamWidth = beamWidth; }
+
+	/*! \brief Sets the amount of random refills each swap gets resolved with
+	*
+	*	\param sampleCount The amount of refills, at least 1
+	*/
+	void SetSampleCount(const uint32_t& sampleCount);
+
+	/*! \brief Sets the amount of threads that search the root swaps
+	*
+	*	\param threadCount The amount of threads, 0 uses one per hardware thread
+	*/
+	void SetThreadCount(const uint32_t& threadCount);
+
+	/*! \brief Restarts the random refills from a seed, so searches without time budget are reproducible
+	*
+	*	\param seed The seed of the random number generator
+	*/
+	void SetSeed(const uint64_t& seed) { m_RandomGenerator.Seed(seed); }
+
+	// returns the depth of the search the last move was chosen with
+	const uint8_t& GetCompletedDepth() const { return m_CompletedDepth; }
+
+private:
+	/*! The state of a single search thread */
+	struct Worker
+	{
+		Worker(const BoardModel& root);
+
+		// the board that gets searched, every swap is rolled back with the journal after its subtree
+		BoardModel board;
+		// the valid swaps of each ply
+		std::vector<std::vector<BoardModel::Move> > moves;
+		// the swaps of each ply that get followed, ranked by their first step
+		std::vector<std::vector<std::pair<int, uint16_t> > > beams;
+		// summary of the last resolved swap
+		BoardModel::CascadeResult result;
+		// draws the seeds of the random refills
+		RandomGenerator randomGenerator;
+	};
+
+	/*! \brief Returns the expected score of the best swap of the board of a worker (max node)
+	*
+	*	\param worker The state of the thread
+	*	\param ply The amount of swaps played since the root
+	*	\param depth The amount of moves to look ahead, at least 1
+	*/
+	int32_t EvaluateBoard(Worker& worker, const size_t& ply, const uint8_t& depth);
+
+	/*! \brief Returns the expected score of a swap, averaged over several random refills (chance node)
+	*
+	*	\param worker The state of the thread, its board is unchanged afterwards
+	*	\param ply The amount of swaps played since the root
+	*	\param move The swap to play
+	*	\param depth The amount of moves to look ahead, including this one
+	*/
+	int32_t EvaluateMove(Worker& worker, const size_t& ply, const BoardModel::Move& move, const uint8_t& depth);
+
+	/*! \brief Searches all root swaps to a fixed depth with all workers
+	*
+	*	\param rootMoves The valid swaps of the board
+	*	\param depth The amount of moves to look ahead
+	*	\param values Receives the expected score of each root swap
+	*/
+	void SearchRoot(const std::vector<BoardModel::Move>& rootMoves, const uint8_t& depth, std::vector<int32_t>& values);
+
+	/*! \brief Checks if the current search has to stop
+	*
+	*	The first caller that notices the deadline tells all the others.
+	*/
+	bool IsTimeUp();
+
+	// search settings
+	uint32_t m_TimeBudget;
+	uint8_t m_MaxDepth;
+	uint32_t m_BeamWidth;
+	uint32_t m_SampleCount;
+	uint32_t m_ThreadCount;
+
+	// depth of the search the last move was chosen with
+	uint8_t m_CompletedDepth;
+
+	// seeds the workers of each search
+	RandomGenerator m_RandomGenerator;
+
+	// scores of boards that have been searched before, shared by all workers
+	TranspositionTable m_Table;
+
+	// state of the threads of the current search
+	std::vector<Worker> m_Workers;
+
+	// end of the time budget of the current move
+	std::chrono::steady_clock::time_point m_Deadline;
+	bool m_HasDeadline;
+	std::atomic<bool> m_IsTimeUp;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef __TILED_BOARD_H__
+#define __TILED_BOARD_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RandomGenerator.h"
+
+/*! A very large board, e.g. 2048x2048 cells, stored as square tiles of 64x64 cells.
+*	A tile holds one byte per cell and fits into the level 1 cache, cells of a tile are stored row by row.
+*	Detection and removal are split across tiles and gravity across columns of tiles,
+*	each running on several threads. The result does not depend on the amount of threads:
+*	every column of tiles draws its new colors from its own random stream.
+*/
+class TiledBoard
+{
+public:
+	// amount of cells along each side of a tile
+	static const uint32_t TILE_SIZE = 64;
+
+	// color value of an empty cell
+	static const uint8_t HOLE = 0xFF;
+
+	/*! \brief Creates a board that consists of holes only
+	*
+	*	\param columns Width of the board in cells
+	*	\param rows Height of the board in cells
+	*	\param threadCount Amount of threads used by the parallel steps, 0 uses one per hardware thread
+	*/
+	TiledBoard(const uint16_t& columns, const uint16_t& rows, const uint32_t& threadCount = 0);
+	virtual ~TiledBoard();
+
+	/*! \brief Fills the whole board with random colors that do not form a sequence
+	*
+	*	\param seed The seed of the colors and of the streams used by DropColors
+	*/
+	void Populate(const uint64_t& seed);
+
+	/*! \brief Retrieves the color of a cell
+	*
+	*	\return The color, 255 for a hole and 0 outside the board
+	*/
+	uint8_t GetColor(const uint16_t& column, const uint16_t& row) const
+	{
+		if (column >= m_Columns || row >= m_Rows)
+			return 0;
+
+		return m_Cells[GetCellIndex(column, row)];
+	}
+
+	/*! \brief Changes the color of a cell
+	*
+	*	\param color The new color or HOLE
+	*/
+	void SetColor(const uint16_t& column, const uint16_t& row, const uint8_t& color)
+	{
+		uint32_t tile = (row / TILE_SIZE) * m_TileColumns + column / TILE_SIZE;
+		uint8_t& cell = m_Cells[GetCellIndex(column, row)];
+
+		// let DropColors know that the column of tiles needs to settle, only count cells that turn into or stop being a hole
+		if (color == HOLE && cell != HOLE)
+		{
+			++m_TileHoles[tile];
+			++m_Holes;
+		}
+		else if (color != HOLE && cell == HOLE)
+		{
+			--m_TileHoles[tile];
+			--m_Holes;
+		}
+
+		cell = color;
+		m_IsTileDirty[tile] = 1;
+	}
+
+	/*! \brief Swaps two cells, the swap is reverted if neither cell becomes part of a sequence
+	*
+	*	\return true if the swap has been kept
+	*/
+	bool SwapColors(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY);
+
+	/*! \brief Flags every cell that is part of a sequence, tiles are processed in parallel
+	*
+	*	Only tiles that changed since the last detection and their neighbours are scanned.
+	*	\return true if the board contains at least one sequence
+	*/
+	bool DetectColorSequences();
+
+	/*! \brief Turns the flagged cells into holes, tiles are processed in parallel
+	*
+	*	\return The amount of cleared cells
+	*/
+	uint32_t RemoveSequences();
+
+	/*! \brief Closes all holes and fills the top of each column with new colors
+	*
+	*	Columns of tiles are processed in parallel, the cells of a column move down across tile borders.
+	*/
+	void DropColors();
+
+	/*! \brief Removes sequences and drops colors until no sequence is left
+	*
+	*	\return The amount of steps of the chain
+	*/
+	uint32_t ResolveCascades();
+
+	// returns the amount of holes on the board
+	const uint32_t& GetHoles() const { return m_Holes; }
+
+	/*! \brief Limits new colors to the first colorCount colors of GemColor
+	*
+	*	\param colorCount Amount of colors between 1 and GemColor::COUNT
+	*/
+	void SetColorCount(const uint8_t& colorCount);
+
+	const uint16_t& GetColumns() const { return m_Columns; }
+	const uint16_t& GetRows() const { return m_Rows; }
+
+private:
+	// returns the position of a cell in the tile storage
+	size_t GetCellIndex(const uint32_t& column, const uint32_t& row) const
+	{
+		size_t tile = (row / TILE_SIZE) * m_TileColumns + column / TILE_SIZE;
+		return tile * TILE_SIZE * TILE_SIZE + (row % TILE_SIZE) * TILE_SIZE + column % TILE_SIZE;
+	}
+
+	/*! \brief Checks if the color of the cell is part of a horizontal or vertical run of three
+	*
+	*	Only reads cells, so several threads can check cells of the same tile.
+	*/
+	bool IsPartOfSequence(const int& cellX, const int& cellY) const;
+
+	/*! \brief Calls a function for every index in [0, count) on the threads of the board
+	*
+	*	\param count The amount of indices
+	*	\param function The function to call with each index
+	*/
+	template <typename Function>
+	void ParallelFor(const uint32_t& count, const Function& function);
+
+	// grid size
+	const uint16_t m_Columns;
+	const uint16_t m_Rows;
+
+	// amount of tiles along each side, tiles at the right and bottom border may be partly used
+	const uint32_t m_TileColumns;
+	const uint32_t m_TileRows;
+
+	// amount of threads used by the parallel steps
+	uint32_t m_ThreadCount;
+
+	// amount of colors that get drawn
+	uint8_t m_ColorCount;
+
+	// amount of holes on the board
+	uint32_t m_Holes;
+
+	// colors of all tiles, tile after tile
+	std::vector<uint8_t> m_Cells;
+	// 1 for cells that are part of a sequence, same layout as m_Cells
+	std::vector<uint8_t> m_SequenceFlags;
+	// holes of each tile, the unused cells of border tiles do not count. DropColors skips columns of tiles without holes
+	std::vector<uint32_t> m_TileHoles;
+	// found sequences of each tile during the last detection
+	std::vector<uint8_t> m_TileHasSequence;
+	// 1 for tiles that changed since the last detection
+	std::vector<uint8_t> m_IsTileDirty;
+	// 1 for tiles the current detection scans
+	std::vector<uint8_t> m_IsTileScanned;
+	// the lowest row that changed in each column of tiles during the last drop, -1 if none
+	std::vector<int> m_LowestChangedRows;
+
+	// one generator per column of tiles for the colors dropped in by DropColors
+	std::vector<RandomGenerator> m_ColumnGenerators;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __TRANSPOSITION_TABLE_H__
+#define __TRANSPOSITION_TABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+/*! A fixed size table of search results keyed by board hash, shared by several threads without locks.
+*	Each slot holds two 64-bit words: the entry and the hash xor-ed with the entry.
+*	A reader only accepts a slot if both words still fit together, so an entry that is torn by
+*	two threads writing at the same time is simply treated as missing.
+*/
+class TranspositionTable
+{
+public:
+	/*! A search result, packed into 64 bits */
+	struct Entry
+	{
+		// score of the position
+		int32_t value;
+		// index of the best move in BoardModel::FindMoves order
+		uint16_t bestMove;
+		// amount of moves the value looks ahead
+		uint8_t depth;
+		// free for the search, e.g. whether value is exact or a bound
+		uint8_t flags;
+	};
+
+	/*! \brief Allocates the table
+	*
+	*	\param sizeInMegabytes Memory to use, rounded down to a power of two amount of slots
+	*/
+	TranspositionTable(const size_t& sizeInMegabytes);
+	virtual ~TranspositionTable();
+
+	/*! \brief Looks up the entry of a board
+	*
+	*	\param hash The hash of the board, e.g. BoardModel::GetHash()
+	*	\param entry Receives the entry if there is one
+	*	\return true if the table holds an entry for the hash
+	*/
+	bool Probe(const uint64_t& hash, Entry& entry) const;
+
+	/*! \brief Stores the entry of a board
+	*
+	*	An entry of another board in the same slot is always replaced,
+	*	an entry of the same board only by an entry that looks at least as far ahead.
+	*
+	*	\param hash The hash of the board
+	*	\param entry The result to store
+	*/
+	void Store(const uint64_t& hash, const Entry& entry);
+
+	/*! Removes all entries, must not run while other threads use the table */
+	void Clear();
+
+	// returns amount of slots
+	const size_t& GetCapacity() const { return m_Capacity; }
+
+private:
+	struct Slot
+	{
+		// hash xor data, lets a reader detect a torn slot
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+
+	static uint64_t Pack(const Entry& entry);
+	static Entry Unpack(const uint64_t& data);
+
+	Slot* m_Slots;
+	size_t m_Capacity;
+	// the slot of a hash is hash & m_IndexMask
+	size_t m_IndexMask;
+};
+
+#endif
@@ -0,0 +1,186 @@
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "BitBoard.h"
+
+namespace
+{
+	// returns the index of the lowest set bit, word must not be zero
+	inline uint32_t CountTrailingZeros(const uint64_t& word)
+	{
+#if defined(_MSC_VER)
+		// 32 bit builds have no 64 bit bit scan
+		unsigned long index;
+		if (_BitScanForward(&index, (unsigned long)word))
+			return index;
+		_BitScanForward(&index, (unsigned long)(word >> 32));
+		return index + 32;
+#else
+		return __builtin_ctzll(word);
+#endif
+	}
+}
+
+BitBoard::BitBoard() :
+m_BitCount(0)
+{
+}
+
+BitBoard::BitBoard(const uint32_t& bitCount) :
+m_BitCount(0)
+{
+	Resize(bitCount);
+}
+
+BitBoard::~BitBoard()
+{
+}
+
+void BitBoard::Resize(const uint32_t& bitCount)
+{
+	m_BitCount = bitCount;
+	m_Words.assign((bitCount + 63) / 64, 0);
+}
+
+void BitBoard::Clear()
+{
+	Clear(0, m_Words.size());
+}
+
+void BitBoard::Clear(const size_t& firstWord, const size_t& endWord)
+{
+	for (size_t i = firstWord; i < endWord; ++i)
+	{
+		m_Words[i] = 0;
+	}
+}
+
+bool BitBoard::Any() const
+{
+	for (const uint64_t& word : m_Words)
+	{
+		if (word != 0)
+			return true;
+	}
+
+	return false;
+}
+
+void BitBoard::Assign(const BitBoard& other)
+{
+	Assign(other, 0, m_Words.size());
+}
+
+void BitBoard::Assign(const BitBoard& other, const size_t& firstWord, const size_t& endWord)
+{
+	for (size_t i = firstWord; i < endWord; ++i)
+	{
+		m_Words[i] = other.m_Words[i];
+	}
+}
+
+void BitBoard::And(const BitBoard& other)
+{
+	And(other, 0, m_Words.size());
+}
+
+void BitBoard::And(const BitBoard& other, const size_t& firstWord, const size_t& endWord)
+{
+	for (size_t i = firstWord; i < endWord; ++i)
+	{
+		m_Words[i] &= other.m_Words[i];
+	}
+}
+
+void BitBoard::Or(const BitBoard& other)
+{
+	Or(other, 0, m_Words.size());
+}
+
+void BitBoard::Or(const BitBoard& other, const size_t& firstWord, const size_t& endWord)
+{
+	for (size_t i = firstWord; i < endWord; ++i)
+	{
+		m_Words[i] |= other.m_Words[i];
+	}
+}
+
+void BitBoard::AndShiftedDown(const BitBoard& source, const uint32_t& shift)
+{
+	AndShiftedDown(source, shift, 0, m_Words.size());
+}
+
+void BitBoard::AndShiftedDown(const BitBoard& source, const uint32_t& shift, const size_t& firstWord, const size_t& endWord)
+{
+	const size_t wordCount = m_Words.size();
+	const size_t wordShift = shift / 64;
+	const uint32_t bitShift = shift % 64;
+
+	// walk upwards: word i only reads source words >= i, so source may be this board
+	for (size_t i = firstWord; i < endWord; ++i)
+	{
+		uint64_t shifted = 0;
+
+		if (i + wordShift < wordCount)
+			shifted = source.m_Words[i + wordShift] >> bitShift;
+
+		if (bitShift != 0 && i + wordShift + 1 < wordCount)
+			shifted |= source.m_Words[i + wordShift + 1] << (64 - bitShift);
+
+		m_Words[i] &= shifted;
+	}
+}
+
+void BitBoard::OrShiftedUp(const BitBoard& source, const uint32_t& shift)
+{
+	OrShiftedUp(source, shift, 0, m_Words.size());
+}
+
+void BitBoard::OrShiftedUp(const BitBoard& source, const uint32_t& shift, const size_t& firstWord, const size_t& endWord)
+{
+	const size_t wordShift = shift / 64;
+	const uint32_t bitShift = shift % 64;
+	const size_t lowestWord = (firstWord > wordShift) ? firstWord : wordShift;
+
+	// walk downwards: word i only reads source words <= i, so source may be this board
+	for (size_t i = endWord; i-- > lowestWord;)
+	{
+		uint64_t shifted = source.m_Words[i - wordShift] << bitShift;
+
+		if (bitShift != 0 && i > wordShift)
+			shifted |= source.m_Words[i - wordShift - 1] >> (64 - bitShift);
+
+		m_Words[i] |= shifted;
+	}
+
+	ClearPadding();
+}
+
+uint32_t BitBoard::FindNext(const uint32_t& from) const
+{
+	if (from >= m_BitCount)
+		return m_BitCount;
+
+	size_t wordIndex = from / 64;
+
+	// ignore the bits in front of the start position
+	uint64_t word = m_Words[wordIndex] & (~uint64_t(0) << (from % 64));
+
+	while (word == 0)
+	{
+		if (++wordIndex >= m_Words.size())
+			return m_BitCount;
+
+		word = m_Words[wordIndex];
+	}
+
+	return uint32_t(wordIndex * 64) + CountTrailingZeros(word);
+}
+
+void BitBoard::ClearPadding()
+{
+	if (m_BitCount % 64 != 0)
+	{
+		m_Words.back() &= (uint64_t(1) << (m_BitCount % 64)) - 1;
+	}
+}
@@ -0,0 +1,309 @@
+#include <algorithm>
+#include "GemColor.h"
+#include "BoardBatch.h"
+
+// pick the widest kernels the compiler targets, define GEMMATCH_NO_SIMD to force the plain loops
+#if defined(GEMMATCH_NO_SIMD)
+	#define BOARD_BATCH_SCALAR
+#elif defined(__AVX2__)
+	#define BOARD_BATCH_AVX2
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define BOARD_BATCH_SSE2
+	#include <emmintrin.h>
+#else
+	#define BOARD_BATCH_SCALAR
+#endif
+
+namespace
+{
+	// all operations work on bytes that are either 0x00 or 0xFF when used as masks
+
+#if defined(BOARD_BATCH_AVX2)
+	typedef __m256i Vector;
+	const uint32_t VECTOR_SIZE = 32;
+	const char* KERNEL_NAME = "AVX2";
+
+	inline Vector Load(const uint8_t* source) { return _mm256_loadu_si256((const __m256i*)source); }
+	inline void Store(uint8_t* target, const Vector& value) { _mm256_storeu_si256((__m256i*)target, value); }
+	inline Vector Fill(const uint8_t& value) { return _mm256_set1_epi8((char)value); }
+	inline Vector Equal(const Vector& a, const Vector& b) { return _mm256_cmpeq_epi8(a, b); }
+	inline Vector And(const Vector& a, const Vector& b) { return _mm256_and_si256(a, b); }
+	inline Vector Or(const Vector& a, const Vector& b) { return _mm256_or_si256(a, b); }
+	// (~a) & b
+	inline Vector AndNot(const Vector& a, const Vector& b) { return _mm256_andnot_si256(a, b); }
+	inline Vector Subtract(const Vector& a, const Vector& b) { return _mm256_sub_epi8(a, b); }
+	// one bit per byte, taken from the highest bit
+	inline uint32_t MoveMask(const Vector& value) { return (uint32_t)_mm256_movemask_epi8(value); }
+#elif defined(BOARD_BATCH_SSE2)
+	typedef __m128i Vector;
+	const uint32_t VECTOR_SIZE = 16;
+	const char* KERNEL_NAME = "SSE2";
+
+	inline Vector Load(const uint8_t* source) { return _mm_loadu_si128((const __m128i*)source); }
+	inline void Store(uint8_t* target, const Vector& value) { _mm_storeu_si128((__m128i*)target, value); }
+	inline Vector Fill(const uint8_t& value) { return _mm_set1_epi8((char)value); }
+	inline Vector Equal(const Vector& a, const Vector& b) { return _mm_cmpeq_epi8(a, b); }
+	inline Vector And(const Vector& a, const Vector& b) { return _mm_and_si128(a, b); }
+	inline Vector Or(const Vector& a, const Vector& b) { return _mm_or_si128(a, b); }
+	inline Vector AndNot(const Vector& a, const Vector& b) { return _mm_andnot_si128(a, b); }
+	inline Vector Subtract(const Vector& a, const Vector& b) { return _mm_sub_epi8(a, b); }
+	inline uint32_t MoveMask(const Vector& value) { return (uint32_t)_mm_movemask_epi8(value); }
+#else
+	typedef uint8_t Vector;
+	const uint32_t VECTOR_SIZE = 1;
+	const char* KERNEL_NAME = "scalar";
+
+	inline Vector Load(const uint8_t* source) { return *source; }
+	inline void Store(uint8_t* target, const Vector& value) { *target = value; }
+	inline Vector Fill(const uint8_t& value) { return value; }
+	inline Vector Equal(const Vector& a, const Vector& b) { return a == b ? 0xFF : 0x00; }
+	inline Vector And(const Vector& a, const Vector& b) { return a & b; }
+	inline Vector Or(const Vector& a, const Vector& b) { return a | b; }
+	inline Vector AndNot(const Vector& a, const Vector& b) { return (uint8_t)~a & b; }
+	inline Vector Subtract(const Vector& a, const Vector& b) { return (uint8_t)(a - b); }
+	inline uint32_t MoveMask(const Vector& value) { return value >> 7; }
+#endif
+
+	/*! \brief Marks every cell that starts a run of three equal colors, and the two cells after it
+	*
+	*	\param cells The colors, the run continues at cells + stride and cells + 2 * stride
+	*	\param flags The sequence flags in the same layout
+	*	\param stride The distance between neighbouring cells of the run in bytes
+	*	\param count The amount of bytes to check, a multiple of the vector size
+	*/
+	void MarkRuns(const uint8_t* cells, uint8_t* flags, const uint32_t& stride, const uint32_t& count)
+	{
+		const Vector hole = Fill(BoardBatch::HOLE);
+
+		for (uint32_t i = 0; i < count; i += VECTOR_SIZE)
+		{
+			Vector first = Load(cells + i);
+			Vector second = Load(cells + i + stride);
+			Vector third = Load(cells + i + 2 * stride);
+
+			Vector isRun = AndNot(Equal(first, hole), And(Equal(first, second), Equal(second, third)));
+
+			Store(flags + i, Or(Load(flags + i), isRun));
+			Store(flags + i + stride, Or(Load(flags + i + stride), isRun));
+			Store(flags + i + 2 * stride, Or(Load(flags + i + 2 * stride), isRun));
+		}
+	}
+
+	/*! \brief Turns flagged cells into holes and counts them per lane
+	*
+	*	\param cells The colors of one or more cells
+	*	\param flags The sequence flags of the same cells
+	*	\param counts One counter per lane, increased for every flagged cell
+	*	\param count The amount of bytes, a multiple of the lane count
+	*/
+	void ClearFlagged(uint8_t* cells, const uint8_t* flags, uint8_t* counts, const uint32_t& count)
+	{
+		for (uint32_t i = 0; i < count; i += VECTOR_SIZE)
+		{
+			Vector isFlagged = Load(flags + i);
+
+			// a hole has all bits set, so or-ing the flag in clears the cell
+			Store(cells + i, Or(Load(cells + i), isFlagged));
+
+			// the flag is -1 as a signed byte
+			uint8_t* laneCounts = counts + i % BoardBatch::LANE_COUNT;
+			Store(laneCounts, Subtract(Load(laneCounts), isFlagged));
+		}
+	}
+
+	/*! \brief Moves colors of the upper row into holes of the lower row
+	*
+	*	\param upper The cells of the upper row, moved colors leave holes
+	*	\param lower The cells of the row beneath
+	*	\param count The amount of bytes of a row
+	*	\return true if at least one color has moved
+	*/
+	bool DropRow(uint8_t* upper, uint8_t* lower, const uint32_t& count)
+	{
+		const Vector hole = Fill(BoardBatch::HOLE);
+		uint32_t hasMoved = 0;
+
+		for (uint32_t i = 0; i < count; i += VECTOR_SIZE)
+		{
+			Vector upperCells = Load(upper + i);
+			Vector lowerCells = Load(lower + i);
+
+			Vector isMoving = AndNot(Equal(upperCells, hole), Equal(lowerCells, hole));
+
+			Store(lower + i, Or(And(isMoving, upperCells), AndNot(isMoving, lowerCells)));
+			Store(upper + i, Or(isMoving, upperCells));
+
+			hasMoved |= MoveMask(isMoving);
+		}
+
+		return hasMoved != 0;
+	}
+}
+
+const uint32_t BoardBatch::LANE_COUNT;
+const uint8_t BoardBatch::HOLE;
+
+BoardBatch::BoardBatch(const uint8_t& columns, const uint8_t& rows) :
+m_Columns(columns),
+m_Rows(rows),
+m_ColorCount((uint8_t)GemColor::COUNT)
+{
+	size_t byteCount = m_Columns * m_Rows * LANE_COUNT;
+
+	m_Cells.assign(byteCount, HOLE);
+	m_SequenceFlags.assign(byteCount, 0);
+	m_StepCounts.assign(LANE_COUNT, 0);
+
+	m_RandomGenerators.resize(LANE_COUNT);
+	m_ChainDepths.assign(LANE_COUNT, 0);
+	m_ClearedCells.assign(LANE_COUNT, 0);
+}
+
+BoardBatch::~BoardBatch()
+{
+}
+
+void BoardBatch::LoadBoard(const uint32_t& lane, BoardModel& board)
+{
+	for (uint8_t y = 0; y < m_Rows; ++y)
+	{
+		for (uint8_t x = 0; x < m_Columns; ++x)
+		{
+			// holes of the board read as 0xFF, which is HOLE
+			SetColor(lane, x, y, board.GetColor(x, y));
+		}
+	}
+
+	m_RandomGenerators[lane] = board.GetRandomGenerator();
+}
+
+void BoardBatch::ApplyMove(const uint32_t& lane, const BoardModel::Move& move)
+{
+	uint8_t& source = m_Cells[(move.sourceY * m_Columns + move.sourceX) * LANE_COUNT + lane];
+	uint8_t& target = m_Cells[(move.targetY * m_Columns + move.targetX) * LANE_COUNT + lane];
+
+	std::swap(source, target);
+}
+
+uint32_t BoardBatch::DetectSequences()
+{
+	std::fill(m_SequenceFlags.begin(), m_SequenceFlags.end(), 0);
+
+	uint32_t rowSize = m_Columns * LANE_COUNT;
+
+	// horizontal runs: a row at a time, each cell compared with the next two columns
+	if (m_Columns >= 3)
+	{
+		for (uint32_t y = 0; y < m_Rows; ++y)
+			MarkRuns(&m_Cells[y * rowSize], &m_SequenceFlags[y * rowSize], LANE_COUNT, (m_Columns - 2) * LANE_COUNT);
+	}
+
+	// vertical runs: the whole board at once, each cell compared with the next two rows
+	if (m_Rows >= 3)
+		MarkRuns(&m_Cells[0], &m_SequenceFlags[0], rowSize, (m_Rows - 2) * rowSize);
+
+	uint32_t laneMask = 0;
+	for (uint32_t i = 0; i < m_SequenceFlags.size(); i += VECTOR_SIZE)
+		laneMask |= MoveMask(Load(&m_SequenceFlags[i])) << (i % LANE_COUNT);
+
+	return laneMask;
+}
+
+void BoardBatch::RemoveSequences()
+{
+	uint32_t rowSize = m_Columns * LANE_COUNT;
+
+	for (uint32_t y = 0; y < m_Rows; ++y)
+	{
+		// a row adds at most m_Columns to each counter, so the byte counters can not overflow
+		std::fill(m_StepCounts.begin(), m_StepCounts.end(), 0);
+
+		ClearFlagged(&m_Cells[y * rowSize], &m_SequenceFlags[y * rowSize], &m_StepCounts[0], rowSize);
+
+		for (uint32_t lane = 0; lane < LANE_COUNT; ++lane)
+			m_ClearedCells[lane] += m_StepCounts[lane];
+	}
+}
+
+void BoardBatch::DropColors()
+{
+	uint32_t rowSize = m_Columns * LANE_COUNT;
+
+	// going from the top down lets a color fall through a whole stack of holes in one pass,
+	// only colors stacked on top of each other need another pass
+	bool hasMoved = true;
+	while (hasMoved)
+	{
+		hasMoved = false;
+
+		for (uint32_t y = 1; y < m_Rows; ++y)
+		{
+			if (DropRow(&m_Cells[(y - 1) * rowSize], &m_Cells[y * rowSize], rowSize))
+				hasMoved = true;
+		}
+	}
+}
+
+void BoardBatch::FillHoles(const uint32_t& laneMask)
+{
+	for (uint32_t lane = 0; lane < LANE_COUNT; ++lane)
+	{
+		if ((laneMask & (1u << lane)) == 0)
+			continue;
+
+		RandomGenerator& randomGenerator = m_RandomGenerators[lane];
+
+		for (uint8_t x = 0; x < m_Columns; ++x)
+		{
+			for (int y = m_Rows - 1; y >= 0; --y)
+			{
+				uint8_t& cell = m_Cells[(y * m_Columns + x) * LANE_COUNT + lane];
+
+				if (cell == HOLE)
+					cell = (uint8_t)randomGenerator.NextBounded(m_ColorCount);
+			}
+		}
+	}
+}
+
+void BoardBatch::ResolveCascades()
+{
+	std::fill(m_ChainDepths.begin(), m_ChainDepths.end(), 0);
+	std::fill(m_ClearedCells.begin(), m_ClearedCells.end(), 0);
+
+	for (;;)
+	{
+		uint32_t laneMask = DetectSequences();
+
+		// every lane has settled
+		if (laneMask == 0)
+			break;
+
+		for (uint32_t lane = 0; lane < LANE_COUNT; ++lane)
+		{
+			if (laneMask & (1u << lane))
+				++m_ChainDepths[lane];
+		}
+
+		// settled lanes have no flags and no holes, the kernels leave them unchanged
+		RemoveSequences();
+		DropColors();
+		FillHoles(laneMask);
+	}
+}
+
+void BoardBatch::SetColorCount(const uint8_t& colorCount)
+{
+	m_ColorCount = std::max<uint8_t>(1, std::min<uint8_t>(colorCount, (uint8_t)GemColor::COUNT));
+}
+
+void BoardBatch::SetRandomGenerator(const uint32_t& lane, const RandomGenerator& randomGenerator)
+{
+	m_RandomGenerators[lane] = randomGenerator;
+}
+
+const char* BoardBatch::GetKernelName()
+{
+	return KERNEL_NAME;
+}
@@ -0,0 +1,1559 @@
+#include <stdlib.h>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include "GemColor.h"
+#include "BoardModel.h"
+
+namespace
+{
+	// amount of patterns that have to be checked for each side of a swap
+	const int PATTERN_COUNT = 4;
+
+	/* The 3-cell patterns a color completes when a swap moves it onto a cell.
+	*	Indexed by swap direction (right, down) and side (the source color landing on the target cell,
+	*	the target color landing on the source cell). Each entry holds the offsets {dx1, dy1, dx2, dy2}
+	*	of the two cells that must already have that color. Patterns that include the other swapped cell
+	*	are left out, as that cell receives the other color.
+	*/
+	const int SWAP_PATTERNS[2][2][PATTERN_COUNT][4] =
+	{
+		// swap with right neighbour
+		{
+			// source color lands one cell to the right
+			{ { 1, 0, 2, 0 }, { 0, -2, 0, -1 }, { 0, -1, 0, 1 }, { 0, 1, 0, 2 } },
+			// target color lands one cell to the left
+			{ { -2, 0, -1, 0 }, { 0, -2, 0, -1 }, { 0, -1, 0, 1 }, { 0, 1, 0, 2 } }
+		},
+		// swap with lower neighbour
+		{
+			// source color lands one cell below
+			{ { 0, 1, 0, 2 }, { -2, 0, -1, 0 }, { -1, 0, 1, 0 }, { 1, 0, 2, 0 } },
+			// target color lands one cell above
+			{ { 0, -2, 0, -1 }, { -2, 0, -1, 0 }, { -1, 0, 1, 0 }, { 1, 0, 2, 0 } }
+		}
+	};
+
+	// bits of the arms around the cell where two runs cross
+	const uint8_t ARM_LEFT = 1;
+	const uint8_t ARM_RIGHT = 2;
+	const uint8_t ARM_UP = 4;
+	const uint8_t ARM_DOWN = 8;
+
+	/* The shape of two crossing runs, indexed by the arms around the crossing cell.
+	*	Each run of three or more adds at least one arm, so only combinations of a horizontal
+	*	and a vertical arm can occur, the others are never looked up.
+	*/
+	const BoardMatch::Shape CROSSING_SHAPES[16] =
+	{
+		BoardMatch::Shape::Line3, BoardMatch::Shape::Line3, BoardMatch::Shape::Line3, BoardMatch::Shape::Line3,
+		// up
+		BoardMatch::Shape::Line3, BoardMatch::Shape::L, BoardMatch::Shape::L, BoardMatch::Shape::T,
+		// down
+		BoardMatch::Shape::Line3, BoardMatch::Shape::L, BoardMatch::Shape::L, BoardMatch::Shape::T,
+		// up and down
+		BoardMatch::Shape::Line3, BoardMatch::Shape::T, BoardMatch::Shape::T, BoardMatch::Shape::Cross
+	};
+
+	// maximum amount of shuffles before the board gets populated again
+	const int MAX_SHUFFLE_ATTEMPTS = 100;
+}
+
+const uint32_t BoardDelta::AllTypes;
+
+BoardModel::BoardModel(const uint16_t& columns, const uint16_t& rows, const Backend& backend) :
+m_Columns(columns),
+m_Rows(rows),
+m_Holes(columns * rows),
+m_ColorCount((uint8_t)GemColor::COUNT),
+m_Backend(backend),
+m_Hash(0),
+m_RecordedDeltaTypes(0),
+m_IsJournalEnabled(false)
+{
+	// create array of colors, all cells start as holes
+	m_Colors = new int[m_Columns * m_Rows];
+	std::fill(m_Colors, m_Colors + m_Columns * m_Rows, -1);
+
+	//init number generator with the current time, use SetSeed() for reproducible runs
+	m_RandomNumberGenerator.Seed(std::chrono::steady_clock::now().time_since_epoch().count());
+
+	// no cell is part of a sequence yet
+	m_ColorSequences.assign(m_Columns * m_Rows, false);
+
+	// no line has been changed yet
+	m_IsRowDirty.assign(m_Rows, false);
+	m_IsColumnDirty.assign(m_Columns, false);
+	m_DirtyRows.reserve(m_Rows);
+	m_DirtyColumns.reserve(m_Columns);
+
+	if (m_Backend == Backend::Bitboard)
+	{
+		int cellCount = m_Columns * m_Rows;
+
+		// one mask per color
+		m_ColorMasks.resize((size_t)GemColor::COUNT, BitBoard(cellCount));
+
+		m_SequenceMask.Resize(cellCount);
+		m_HorizontalStarts.Resize(cellCount);
+		m_VerticalStarts.Resize(cellCount);
+		m_HorizontalRuns.Resize(cellCount);
+		m_VerticalRuns.Resize(cellCount);
+		m_ScratchMask.Resize(cellCount);
+
+		// a horizontal sequence can not start in the last two columns
+		m_HorizontalStartMask.Resize(cellCount);
+		for (int i = 0; i < cellCount; ++i)
+		{
+			if (i % m_Columns < m_Columns - 2)
+				m_HorizontalStartMask.Set(i);
+		}
+	}
+}
+
+BoardModel::BoardModel(const BoardModel& other) :
+m_Columns(other.m_Columns),
+m_Rows(other.m_Rows),
+m_Holes(other.m_Holes),
+m_ColorCount(other.m_ColorCount),
+m_Backend(other.m_Backend),
+m_Hash(other.m_Hash),
+m_ColorSequences(other.m_ColorSequences),
+m_SequenceCells(other.m_SequenceCells),
+m_IsRowDirty(other.m_IsRowDirty),
+m_IsColumnDirty(other.m_IsColumnDirty),
+m_DirtyRows(other.m_DirtyRows),
+m_DirtyColumns(other.m_DirtyColumns),
+m_ColorMasks(other.m_ColorMasks),
+m_SequenceMask(other.m_SequenceMask),
+m_HorizontalStartMask(other.m_HorizontalStartMask),
+m_HorizontalStarts(other.m_HorizontalStarts),
+m_VerticalStarts(other.m_VerticalStarts),
+m_HorizontalRuns(other.m_HorizontalRuns),
+m_VerticalRuns(other.m_VerticalRuns),
+m_ScratchMask(other.m_ScratchMask),
+m_RandomNumberGenerator(other.m_RandomNumberGenerator),
+m_RecordedDeltaTypes(0),
+m_IsJournalEnabled(false)
+{
+	// the copy gets its own color array
+	m_Colors = new int[m_Columns * m_Rows];
+	std::copy(other.m_Colors, other.m_Colors + m_Columns * m_Rows, m_Colors);
+
+	// keep room for the lines of a full rescan
+	m_DirtyRows.reserve(m_Rows);
+	m_DirtyColumns.reserve(m_Columns);
+}
+
+bool BoardModel::CopyFrom(const BoardModel& other)
+{
+	if (m_Columns != other.m_Columns || m_Rows != other.m_Rows || m_Backend != other.m_Backend)
+		return false;
+
+	if (this == &other)
+		return true;
+
+	std::copy(other.m_Colors, other.m_Colors + m_Columns * m_Rows, m_Colors);
+	m_Holes = other.m_Holes;
+	m_ColorCount = other.m_ColorCount;
+	m_Hash = other.m_Hash;
+
+	// same sizes, so none of the assignments allocates
+	m_ColorSequences = other.m_ColorSequences;
+	m_SequenceCells = other.m_SequenceCells;
+	m_IsRowDirty = other.m_IsRowDirty;
+	m_IsColumnDirty = other.m_IsColumnDirty;
+	m_DirtyRows = other.m_DirtyRows;
+	m_DirtyColumns = other.m_DirtyColumns;
+
+	if (m_Backend == Backend::Bitboard)
+	{
+		for (size_t i = 0; i < m_ColorMasks.size(); ++i)
+			m_ColorMasks[i].Assign(other.m_ColorMasks[i]);
+
+		m_SequenceMask.Assign(other.m_SequenceMask);
+	}
+
+	m_RandomNumberGenerator = other.m_RandomNumberGenerator;
+
+	// deltas belong to the step that was made on the other board
+	m_Deltas.clear();
+
+	// the recorded changes lead to a state this board no longer has
+	m_Journal.clear();
+
+	return true;
+}
+
+BoardModel::~BoardModel()
+{
+
+	m_ColorSequences.clear();
+
+	// delete m_Colors array
+	delete[] m_Colors;
+
+
+}
+
+
+
+void BoardModel::Reset()
+{
+	int cellCount = m_Columns * m_Rows;
+
+	// all cells become holes again, the storage is kept
+	std::fill(m_Colors, m_Colors + cellCount, -1);
+	m_Holes = cellCount;
+
+	ClearSequences();
+	ClearDirtyLines();
+	RebuildColorMasks();
+	RebuildHash();
+	m_Journal.clear();
+
+	m_Deltas.clear();
+}
+
+void BoardModel::SetColor(const uint16_t& column, const uint16_t& row, const int& color)
+{
+	if (column >= m_Columns || row >= m_Rows)
+		return;
+
+	int position = row * m_Columns + column;
+
+	// keep track of the holes
+	if (m_Colors[position] < 0 && color >= 0)
+		--m_Holes;
+	else if (m_Colors[position] >= 0 && color < 0)
+		++m_Holes;
+
+	SetCellColor(position, color);
+}
+
+void BoardModel::SaveSnapshot(Snapshot& snapshot) const
+{
+	int cellCount = m_Columns * m_Rows;
+
+	snapshot.colors.resize(cellCount);
+	memcpy(snapshot.colors.data(), m_Colors, cellCount * sizeof(int));
+
+	snapshot.holes = m_Holes;
+	snapshot.colorCount = m_ColorCount;
+	snapshot.hash = m_Hash;
+	snapshot.randomGenerator = m_RandomNumberGenerator;
+}
+
+void BoardModel::RestoreSnapshot(const Snapshot& snapshot)
+{
+	int cellCount = m_Columns * m_Rows;
+
+	if (snapshot.colors.size() != (size_t)cellCount)
+		return;
+
+	memcpy(m_Colors, snapshot.colors.data(), cellCount * sizeof(int));
+
+	m_Holes = snapshot.holes;
+	m_ColorCount = snapshot.colorCount;
+	m_Hash = snapshot.hash;
+	m_RandomNumberGenerator = snapshot.randomGenerator;
+
+	// the masks and the detection state follow the colors
+	RebuildColorMasks();
+	ClearSequences();
+	MarkAllDirty();
+
+	m_Deltas.clear();
+	m_Journal.clear();
+}
+
+void BoardModel::SetJournalEnabled(const bool& isEnabled)
+{
+	m_IsJournalEnabled = isEnabled;
+	m_Journal.clear();
+}
+
+BoardModel::JournalMark BoardModel::GetJournalMark() const
+{
+	bool needsDetection = m_DirtyRows.empty() == false || m_DirtyColumns.empty() == false || m_SequenceCells.empty() == false;
+
+	JournalMark mark = { m_Journal.size(), m_Holes, needsDetection, m_RandomNumberGenerator };
+	return mark;
+}
+
+void BoardModel::Rollback(const JournalMark& mark)
+{
+	if (mark.length > m_Journal.size())
+		return;
+
+	// newest first, so every cell ends with the color it had at the mark
+	for (size_t i = m_Journal.size(); i > mark.length; --i)
+	{
+		const JournalEntry& entry = m_Journal[i - 1];
+		int position = entry.position;
+		int currentColor = m_Colors[position];
+
+		if (m_Backend == Backend::Bitboard)
+		{
+			if (currentColor >= 0)
+				m_ColorMasks[currentColor].Reset(position);
+			if (entry.color >= 0)
+				m_ColorMasks[entry.color].Set(position);
+		}
+
+		m_Hash ^= GetZobristKey(position, currentColor) ^ GetZobristKey(position, entry.color);
+		m_Colors[position] = entry.color;
+	}
+
+	m_Journal.resize(mark.length);
+
+	m_Holes = mark.holes;
+	m_RandomNumberGenerator = mark.randomGenerator;
+
+	// sequences found after the mark are gone
+	ClearSequences();
+
+	// the lines that were pending at the mark may have been cleared by a detection since, so all of them get scanned.
+	// otherwise the lines changed after the mark hold their scanned colors of the mark again
+	if (mark.needsDetection)
+		MarkAllDirty();
+	else
+		ClearDirtyLines();
+
+	m_Deltas.clear();
+}
+
+bool BoardModel::SwapColors(uint16_t const& sourceX, uint16_t const& sourceY, uint16_t const& targetX, uint16_t const& targetY)
+{
+	// check if source color is valid
+	if (sourceX < 0 || sourceX > m_Columns -1 || sourceY < 0 || sourceY > m_Rows - 1 )
+		return false;
+
+	// check if target color is valid
+	if (targetX < 0 || targetX > m_Columns -1  || targetY < 0 || targetY > m_Rows - 1 )
+		return false;
+
+	int sourcePosition = sourceY * m_Columns + sourceX;
+	int targetPosition = targetY * m_Columns + targetX;
+
+	// attempt to swap colors - check if the swap leads to a sequence
+	int sourceColor = m_Colors[sourceY * m_Columns + sourceX];
+	int targetColor = m_Colors[targetY * m_Columns + targetX];
+
+	// try the swap on colors and masks only, a rejected swap marks no lines dirty and leaves no journal entries
+	ExchangeCellColors(sourcePosition, targetPosition);
+
+	// check if one of them is now part of a sequence
+	bool isKept = IsPartOfSequence(sourceX, sourceY) || IsPartOfSequence(targetX, targetY);
+
+	// reverse swap
+	ExchangeCellColors(sourcePosition, targetPosition);
+
+	if (isKept == false)
+		return false;
+
+	// keep the swap with the full bookkeeping
+	SetCellColor(sourcePosition, targetColor);
+	SetCellColor(targetPosition, sourceColor);
+
+	return true;
+}
+
+void BoardModel::Populate()
+{
+	int cellCount = m_Columns * m_Rows;
+
+	// start with an empty board
+	std::fill(m_Colors, m_Colors + cellCount, -1);
+
+	// plant a pattern that can be completed by a single swap, so that the board is always playable
+	PlantMove();
+
+	// fill the remaining cells, each one with a single draw from the colors that do not create a sequence
+	uint8_t allowedColors[(size_t)GemColor::COUNT];
+
+	for (int position = 0; position < cellCount; ++position)
+	{
+		// skip the planted cells
+		if (m_Colors[position] != -1)
+			continue;
+
+		int allowedCount = 0;
+		for (uint8_t color = 0; color < m_ColorCount; ++color)
+		{
+			if (CompletesSequence(position, color) == false)
+				allowedColors[allowedCount++] = color;
+		}
+
+		// with five colors there are more colors than neighbours that can rule them out, fewer colors may run out
+		if (allowedCount == 0)
+			m_Colors[position] = GetRandomColor();
+		else
+			m_Colors[position] = allowedColors[m_RandomNumberGenerator.NextBounded(allowedCount)];
+	}
+
+	m_Holes = 0;
+
+	RebuildColorMasks();
+	RebuildHash();
+	m_Journal.clear();
+
+	// the whole board is new
+	MarkAllDirty();
+}
+
+void BoardModel::PlantMove()
+{
+	bool canPlantHorizontal = m_Columns >= 3 && m_Rows >= 2;
+	bool canPlantVertical = m_Rows >= 3 && m_Columns >= 2;
+
+	// the board is too small for any sequence
+	if (canPlantHorizontal == false && canPlantVertical == false)
+		return;
+
+	bool isHorizontal = canPlantHorizontal;
+	if (canPlantHorizontal && canPlantVertical)
+		isHorizontal = m_RandomNumberGenerator.NextBounded(2) == 0;
+
+	// the pattern is laid out along a line of three cells: two cells on the line share a color,
+	// the third one sits next to the last cell of the line and completes it when swapped in
+	int lineLength = isHorizontal ? m_Columns : m_Rows;
+	int crossLength = isHorizontal ? m_Rows : m_Columns;
+
+	int lineStart = m_RandomNumberGenerator.NextBounded(lineLength - 2);
+	int line = m_RandomNumberGenerator.NextBounded(crossLength);
+
+	// the third cell sits on the neighbouring line, before or after the pattern line
+	int neighbourLine = line + 1;
+	if (line == crossLength - 1 || (line > 0 && m_RandomNumberGenerator.NextBounded(2) == 0))
+		neighbourLine = line - 1;
+
+	uint8_t color = GetRandomColor();
+
+	if (isHorizontal)
+	{
+		m_Colors[line * m_Columns + lineStart] = color;
+		m_Colors[line * m_Columns + lineStart + 1] = color;
+		m_Colors[neighbourLine * m_Columns + lineStart + 2] = color;
+	}
+	else
+	{
+		m_Colors[lineStart * m_Columns + line] = color;
+		m_Colors[(lineStart + 1) * m_Columns + line] = color;
+		m_Colors[(lineStart + 2) * m_Columns + neighbourLine] = color;
+	}
+}
+
+bool BoardModel::CompletesSequence(const int& position, const int& color)
+{
+	int x = position % m_Columns;
+	int y = position / m_Columns;
+
+	// horizontal: two cells to the left, one on each side, two to the right
+	if (x > 1 && m_Colors[position - 1] == color && m_Colors[position - 2] == color)
+		return true;
+	if (x > 0 && x < m_Columns - 1 && m_Colors[position - 1] == color && m_Colors[position + 1] == color)
+		return true;
+	if (x < m_Columns - 2 && m_Colors[position + 1] == color && m_Colors[position + 2] == color)
+		return true;
+
+	// vertical: two cells above, one on each side, two below
+	if (y > 1 && m_Colors[position - m_Columns] == color && m_Colors[position - 2 * m_Columns] == color)
+		return true;
+	if (y > 0 && y < m_Rows - 1 && m_Colors[position - m_Columns] == color && m_Colors[position + m_Columns] == color)
+		return true;
+	if (y < m_Rows - 2 && m_Colors[position + m_Columns] == color && m_Colors[position + 2 * m_Columns] == color)
+		return true;
+
+	return false;
+}
+
+bool BoardModel::CompletesPattern(const int& cellX, const int& cellY, const int& color, const int (*patterns)[4])
+{
+	for (int i = 0; i < PATTERN_COUNT; ++i)
+	{
+		int firstX = cellX + patterns[i][0];
+		int firstY = cellY + patterns[i][1];
+		int secondX = cellX + patterns[i][2];
+		int secondY = cellY + patterns[i][3];
+
+		// both cells must be on the board
+		if (firstX < 0 || firstY < 0 || secondX < 0 || secondY < 0
+			|| firstX >= m_Columns || secondX >= m_Columns || firstY >= m_Rows || secondY >= m_Rows)
+			continue;
+
+		if (m_Colors[firstY * m_Columns + firstX] == color && m_Colors[secondY * m_Columns + secondX] == color)
+			return true;
+	}
+
+	return false;
+}
+
+bool BoardModel::IsValidMove(const int& position, const int& direction)
+{
+	int x = position % m_Columns;
+	int y = position / m_Columns;
+	int targetX = x + (direction == 0 ? 1 : 0);
+	int targetY = y + (direction == 0 ? 0 : 1);
+
+	if (targetX >= m_Columns || targetY >= m_Rows)
+		return false;
+
+	int sourceColor = m_Colors[position];
+	int targetColor = m_Colors[targetY * m_Columns + targetX];
+
+	// swapping equal colors or holes changes nothing
+	if (sourceColor == targetColor || sourceColor < 0 || targetColor < 0)
+		return false;
+
+	return CompletesPattern(targetX, targetY, sourceColor, SWAP_PATTERNS[direction][0])
+		|| CompletesPattern(x, y, targetColor, SWAP_PATTERNS[direction][1]);
+}
+
+void BoardModel::FindMoves(std::vector<Move>& moves)
+{
+	moves.clear();
+
+	for (int position = 0; position < m_Columns * m_Rows; ++position)
+	{
+		for (int direction = 0; direction < 2; ++direction)
+		{
+			if (IsValidMove(position, direction))
+			{
+				uint16_t x = position % m_Columns;
+				uint16_t y = position / m_Columns;
+
+				Move move = { x, y, (uint16_t)(x + (direction == 0 ? 1 : 0)), (uint16_t)(y + (direction == 0 ? 0 : 1)) };
+				moves.push_back(move);
+			}
+		}
+	}
+}
+
+bool BoardModel::HasMoves()
+{
+	for (int position = 0; position < m_Columns * m_Rows; ++position)
+	{
+		if (IsValidMove(position, 0) || IsValidMove(position, 1))
+			return true;
+	}
+
+	return false;
+}
+
+int BoardModel::CountSequenceCells(const int& cellX, const int& cellY)
+{
+	int color = m_Colors[cellY * m_Columns + cellX];
+
+	// measure the horizontal run through the cell
+	int left = cellX;
+	while (left > 0 && m_Colors[cellY * m_Columns + left - 1] == color)
+		--left;
+	int right = cellX;
+	while (right < m_Columns - 1 && m_Colors[cellY * m_Columns + right + 1] == color)
+		++right;
+
+	// measure the vertical run through the cell
+	int top = cellY;
+	while (top > 0 && m_Colors[(top - 1) * m_Columns + cellX] == color)
+		--top;
+	int bottom = cellY;
+	while (bottom < m_Rows - 1 && m_Colors[(bottom + 1) * m_Columns + cellX] == color)
+		++bottom;
+
+	int horizontalCount = right - left + 1;
+	int verticalCount = bottom - top + 1;
+
+	int count = 0;
+	if (horizontalCount >= 3)
+		count += horizontalCount;
+	if (verticalCount >= 3)
+		count += verticalCount;
+
+	// the cell itself belongs to both runs
+	if (horizontalCount >= 3 && verticalCount >= 3)
+		--count;
+
+	return count;
+}
+
+int BoardModel::CountMoveMatches(const Move& move)
+{
+	int sourcePosition = move.sourceY * m_Columns + move.sourceX;
+	int targetPosition = move.targetY * m_Columns + move.targetX;
+
+	int sourceColor = m_Colors[sourcePosition];
+	int targetColor = m_Colors[targetPosition];
+
+	// swapping equal colors or holes changes nothing
+	if (sourceColor == targetColor || sourceColor < 0 || targetColor < 0)
+		return 0;
+
+	// swap temporarily, the color masks and dirty lines are not needed for counting
+	m_Colors[sourcePosition] = targetColor;
+	m_Colors[targetPosition] = sourceColor;
+
+	// the two cells have different colors, so their sequences never overlap
+	int count = CountSequenceCells(move.sourceX, move.sourceY) + CountSequenceCells(move.targetX, move.targetY);
+
+	m_Colors[sourcePosition] = sourceColor;
+	m_Colors[targetPosition] = targetColor;
+
+	return count;
+}
+
+bool BoardModel::ContainsAnySequence()
+{
+	for (int y = 0; y < m_Rows; ++y)
+	{
+		for (int x = 0; x < m_Columns; ++x)
+		{
+			if (IsPartOfSequence(x, y))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool BoardModel::CompletesEarlierSequence(const int& position, const int& color)
+{
+	int x = position % m_Columns;
+	int y = position / m_Columns;
+
+	// the two cells to the left
+	if (x > 1 && m_Colors[position - 1] == color && m_Colors[position - 2] == color)
+		return true;
+
+	// the two cells above
+	if (y > 1 && m_Colors[position - m_Columns] == color && m_Colors[position - 2 * m_Columns] == color)
+		return true;
+
+	return false;
+}
+
+void BoardModel::Shuffle()
+{
+	int cellCount = m_Columns * m_Rows;
+
+	for (int attempt = 0; attempt < MAX_SHUFFLE_ATTEMPTS; ++attempt)
+	{
+		// Fisher-Yates shuffle
+		for (int position = cellCount - 1; position > 0; --position)
+		{
+			std::swap(m_Colors[position], m_Colors[m_RandomNumberGenerator.NextBounded(position + 1)]);
+		}
+
+		// break up sequences: exchange a cell that completes a sequence with a later cell that does not
+		for (int position = 0; position < cellCount - 1; ++position)
+		{
+			if (CompletesEarlierSequence(position, m_Colors[position]) == false)
+				continue;
+
+			int laterCount = cellCount - position - 1;
+			int offset = m_RandomNumberGenerator.NextBounded(laterCount);
+
+			for (int i = 0; i < laterCount; ++i)
+			{
+				int swapPosition = position + 1 + (offset + i) % laterCount;
+
+				if (CompletesEarlierSequence(position, m_Colors[swapPosition]) == false)
+				{
+					std::swap(m_Colors[position], m_Colors[swapPosition]);
+					break;
+				}
+			}
+		}
+
+		RebuildColorMasks();
+
+		if (ContainsAnySequence() == false && HasMoves() == true)
+		{
+			// the whole board is new
+			MarkAllDirty();
+			RebuildHash();
+			m_Journal.clear();
+			return;
+		}
+	}
+
+	// the colors can not be arranged into a playable board, populating always creates one
+	Populate();
+}
+
+void BoardModel::DetectColorSequences()
+{
+	m_Deltas.clear();
+
+	// only lines that changed since the last detection can contain a new sequence
+	std::sort(m_DirtyRows.begin(), m_DirtyRows.end());
+	std::sort(m_DirtyColumns.begin(), m_DirtyColumns.end());
+
+	// every cell that changed is on a dirty row, rows further away than two from them held no sequence and still do not
+	int firstRow = m_DirtyRows.empty() ? 0 : std::max(m_DirtyRows.front() - 2, 0);
+	int lastRow = m_DirtyRows.empty() ? -1 : std::min(m_DirtyRows.back() + 2, m_Rows - 1);
+
+	if (m_Backend == Backend::Bitboard)
+	{
+		DetectColorSequencesBitboard(firstRow, lastRow);
+	}
+	else
+	{
+		// traverse the changed rows to find horizontal color sequences
+		for (uint16_t y : m_DirtyRows)
+		{
+			int rowStart = y * m_Columns;
+			int x = 0;
+
+			while (x < m_Columns)
+			{
+				int color = m_Colors[rowStart + x];
+
+				// measure the run of equal colors that starts here
+				int sequenceCount = 1;
+				while (x + sequenceCount < m_Columns && m_Colors[rowStart + x + sequenceCount] == color)
+					++sequenceCount;
+
+				// check if a sequence of at least 3 horizontal matching colors has been found
+				if (sequenceCount >= 3 && color >= 0)
+				{
+					for (int sequence = 0; sequence < sequenceCount; ++sequence)
+					{
+						MarkSequenceCell(rowStart + x + sequence);
+
+						// call handler
+						Notify(BoardDelta::Type::SequenceFound, x + sequence, y, color);
+					}
+				}
+
+				// continue behind the run
+				x += sequenceCount;
+			}
+		}
+
+		// traverse the changed columns to find vertical color sequences, near the changed rows only
+		for (uint16_t x : m_DirtyColumns)
+		{
+			int y = firstRow;
+
+			while (y <= lastRow)
+			{
+				int color = m_Colors[y * m_Columns + x];
+
+				// measure the run of equal colors that starts here
+				int sequenceCount = 1;
+				while (y + sequenceCount <= lastRow && m_Colors[(y + sequenceCount) * m_Columns + x] == color)
+					++sequenceCount;
+
+				// check if a sequence of at least 3 vertical matching colors has been found
+				if (sequenceCount >= 3 && color >= 0)
+				{
+					for (int sequence = 0; sequence < sequenceCount; ++sequence)
+					{
+						MarkSequenceCell((y + sequence) * m_Columns + x);
+
+						// call handler
+						Notify(BoardDelta::Type::SequenceFound, x, y + sequence, color);
+					}
+				}
+
+				// continue behind the run
+				y += sequenceCount;
+			}
+		}
+	}
+
+	// every change has been looked at
+	ClearDirtyLines();
+}
+
+void BoardModel::ClassifyMatches(std::vector<BoardMatch>& matches, std::vector<uint32_t>& cells)
+{
+	matches.clear();
+	cells.clear();
+	m_MatchRuns.clear();
+
+	m_HorizontalRunIds.assign(m_Columns * m_Rows, -1);
+
+	// horizontal runs, every cell is looked at once
+	for (int y = 0; y < m_Rows; ++y)
+	{
+		int rowStart = y * m_Columns;
+		int x = 0;
+
+		while (x < m_Columns)
+		{
+			int color = m_Colors[rowStart + x];
+
+			int runLength = 1;
+			while (x + runLength < m_Columns && m_Colors[rowStart + x + runLength] == color)
+				++runLength;
+
+			if (runLength >= 3 && color >= 0)
+			{
+				uint32_t runIndex = (uint32_t)m_MatchRuns.size();
+				MatchRun run = { (uint32_t)(rowStart + x), (uint16_t)runLength, 1, runIndex, 0, 0, 0 };
+				m_MatchRuns.push_back(run);
+
+				for (int i = 0; i < runLength; ++i)
+					m_HorizontalRunIds[rowStart + x + i] = runIndex;
+			}
+
+			x += runLength;
+		}
+	}
+
+	// vertical runs, joined with the horizontal runs they cross
+	for (int x = 0; x < m_Columns; ++x)
+	{
+		int y = 0;
+
+		while (y < m_Rows)
+		{
+			int color = m_Colors[y * m_Columns + x];
+
+			int runLength = 1;
+			while (y + runLength < m_Rows && m_Colors[(y + runLength) * m_Columns + x] == color)
+				++runLength;
+
+			if (runLength >= 3 && color >= 0)
+			{
+				uint32_t runIndex = (uint32_t)m_MatchRuns.size();
+				MatchRun run = { (uint32_t)(y * m_Columns + x), (uint16_t)runLength, m_Columns, runIndex, 0, 0, 0 };
+				m_MatchRuns.push_back(run);
+
+				for (int i = 0; i < runLength; ++i)
+				{
+					int position = (y + i) * m_Columns + x;
+					int horizontalIndex = m_HorizontalRunIds[position];
+
+					if (horizontalIndex < 0)
+						continue;
+
+					// the arms around the crossing cell tell the shape
+					const MatchRun& horizontal = m_MatchRuns[horizontalIndex];
+					int offset = x - horizontal.startCell % m_Columns;
+
+					uint8_t arms = (offset > 0 ? ARM_LEFT : 0) | (offset < horizontal.length - 1 ? ARM_RIGHT : 0) |
+						(i > 0 ? ARM_UP : 0) | (i < runLength - 1 ? ARM_DOWN : 0);
+
+					// keep the crossing with the strongest shape
+					MatchRun& vertical = m_MatchRuns[runIndex];
+					if (vertical.arms == 0 || CROSSING_SHAPES[arms] > CROSSING_SHAPES[vertical.arms])
+					{
+						vertical.arms = arms;
+						vertical.crossingCell = position;
+					}
+
+					// join both runs, the lower index stays
+					uint32_t horizontalRoot = FindMatchRun(horizontalIndex);
+					uint32_t verticalRoot = FindMatchRun(runIndex);
+					if (horizontalRoot != verticalRoot)
+						m_MatchRuns[std::max(horizontalRoot, verticalRoot)].parent = std::min(horizontalRoot, verticalRoot);
+				}
+			}
+
+			y += runLength;
+		}
+	}
+
+	// one match per group of joined runs, the shape of the strongest run or crossing wins
+	for (uint32_t i = 0; i < m_MatchRuns.size(); ++i)
+	{
+		MatchRun& run = m_MatchRuns[i];
+		uint32_t root = FindMatchRun(i);
+		uint32_t middleCell = run.startCell + (run.length / 2) * run.step;
+
+		if (root == i)
+		{
+			run.matchIndex = (uint32_t)matches.size();
+
+			BoardMatch match = { BoardMatch::Shape::Line3, (uint8_t)m_Colors[run.startCell], middleCell, 0, 0 };
+			matches.push_back(match);
+		}
+
+		BoardMatch& match = matches[m_MatchRuns[root].matchIndex];
+
+		// the crossing cells have been counted with the horizontal run
+		uint32_t cellCount = run.length;
+		if (run.step != 1)
+		{
+			for (int k = 0; k < run.length; ++k)
+			{
+				if (m_HorizontalRunIds[run.startCell + k * run.step] >= 0)
+					--cellCount;
+			}
+		}
+		match.cellCount += cellCount;
+
+		if (run.length >= 5)
+		{
+			match.shape = BoardMatch::Shape::Line5;
+			match.pivotCell = middleCell;
+		}
+		else if (match.shape == BoardMatch::Shape::Line5)
+		{
+			continue;
+		}
+		else if (run.arms != 0 && (match.shape < BoardMatch::Shape::L || CROSSING_SHAPES[run.arms] > match.shape))
+		{
+			match.shape = CROSSING_SHAPES[run.arms];
+			match.pivotCell = run.crossingCell;
+		}
+		else if (run.length == 4 && match.shape == BoardMatch::Shape::Line3)
+		{
+			match.shape = BoardMatch::Shape::Line4;
+			match.pivotCell = middleCell;
+		}
+	}
+
+	// give every match its part of the cell list
+	uint32_t cellCount = 0;
+	for (BoardMatch& match : matches)
+	{
+		match.firstCell = cellCount;
+		cellCount += match.cellCount;
+		match.cellCount = 0;
+	}
+
+	cells.resize(cellCount);
+
+	for (uint32_t i = 0; i < m_MatchRuns.size(); ++i)
+	{
+		const MatchRun& run = m_MatchRuns[i];
+		BoardMatch& match = matches[m_MatchRuns[FindMatchRun(i)].matchIndex];
+
+		for (int k = 0; k < run.length; ++k)
+		{
+			uint32_t position = run.startCell + k * run.step;
+
+			if (run.step == 1 || m_HorizontalRunIds[position] < 0)
+				cells[match.firstCell + match.cellCount++] = position;
+		}
+	}
+}
+
+uint32_t BoardModel::FindMatchRun(const uint32_t& runIndex)
+{
+	uint32_t index = runIndex;
+
+	// halve the path on the way, so later lookups are shorter
+	while (m_MatchRuns[index].parent != index)
+	{
+		m_MatchRuns[index].parent = m_MatchRuns[m_MatchRuns[index].parent].parent;
+		index = m_MatchRuns[index].parent;
+	}
+
+	return index;
+}
+
+bool const BoardModel::ContainsSequences()
+{
+	return m_SequenceCells.empty() == false;
+}
+
+void BoardModel::RemoveSequences()
+{
+	m_Deltas.clear();
+
+	// visit the marked cells row by row, like a scan of the whole board would
+	std::sort(m_SequenceCells.begin(), m_SequenceCells.end());
+
+	for (uint32_t position : m_SequenceCells)
+	{
+		int color = m_Colors[position];
+		SetCellColor(position, -1);
+
+		// invoke removal event
+		Notify(BoardDelta::Type::ColorRemoved, position % m_Columns, position / m_Columns, color);
+
+		//track how many holes there are after removal
+		++m_Holes;
+	}
+
+	//reset valid color sequences
+	ClearSequences();
+}
+
+const uint8_t BoardModel::GetColor(const uint16_t& column, const uint16_t& row) const
+{
+	if (row >= 0 && row < m_Rows && column >= 0 && column < m_Columns)
+	{
+		return m_Colors[row * m_Columns + column];
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+void BoardModel::PrintValidSequences()
+{
+
+	for (int i = 0; i < m_Rows * m_Columns; ++i)
+	{
+		if ((i % m_Columns) == 0)
+			std::cout << std::endl;
+
+		if (m_Backend == Backend::Bitboard)
+			std::cout << m_SequenceMask.Test(i) << " ";
+		else
+			std::cout << m_ColorSequences.at(i) << " ";
+	}
+	// new line
+	std::cout << std::endl;
+}
+
+void BoardModel::DropColors()
+{
+	m_Deltas.clear();
+
+	// iterate through the board from behind and look for holes
+	for (int y = m_Rows - 1; y >= 0; --y)
+	{
+		for (int x = m_Columns - 1; x >= 0; --x)
+		{
+			int position = y * m_Columns + x;
+
+			// check if there is a hole here
+			if (m_Colors[position] == -1)
+			{
+				// get position of color above
+				int swapPosition = position - m_Columns;
+
+				// if the position is is within the field, move the color down one cell
+				if (swapPosition >= 0)
+				{
+					SetCellColor(position, m_Colors[swapPosition]);
+					SetCellColor(swapPosition, -1);
+
+					// check if a hole has been closed
+					if (m_Colors[position] != -1)
+					{
+						// invoke color dropped event
+						Notify(BoardDelta::Type::ColorDropped, x, y - 1, m_Colors[position]);
+					}
+				}
+				else
+				// the hole is at the top row and it gets closed with a new random color
+				{
+					SetCellColor(position, GetRandomColor());
+
+					// invoke color added event
+					Notify(BoardDelta::Type::ColorAdded, x, y, m_Colors[position]);
+
+					// one hole has bubbled up all the way to the top and has been removed
+					--m_Holes;
+				}
+
+			}
+		}
+	}
+}
+
+void BoardModel::CompactColors(std::vector<DropMove>& moves)
+{
+	m_Deltas.clear();
+	moves.clear();
+
+	for (int x = 0; x < m_Columns; ++x)
+	{
+		// the lowest cell that has not been settled yet
+		int targetRow = m_Rows - 1;
+
+		// move every color down to the lowest free cell
+		for (int y = m_Rows - 1; y >= 0; --y)
+		{
+			int color = m_Colors[y * m_Columns + x];
+
+			if (color != -1)
+			{
+				if (y != targetRow)
+				{
+					SetCellColor(targetRow * m_Columns + x, color);
+
+					DropMove move = { (uint16_t)x, (int32_t)y, (uint16_t)targetRow, false };
+					moves.push_back(move);
+				}
+
+				--targetRow;
+			}
+		}
+
+		// fill the cells above with new colors that fall in from outside the board
+		int spawnCount = targetRow + 1;
+
+		for (int y = targetRow; y >= 0; --y)
+		{
+			SetCellColor(y * m_Columns + x, GetRandomColor());
+
+			DropMove move = { (uint16_t)x, (int32_t)(y - spawnCount), (uint16_t)y, true };
+			moves.push_back(move);
+		}
+	}
+
+	// all holes have been closed
+	m_Holes = 0;
+}
+
+bool BoardModel::ResolveMove(const Move& move, CascadeResult& result)
+{
+	result.clearedCells.clear();
+	result.spawnedColors.clear();
+
+	result.isValid = SwapColors(move.sourceX, move.sourceY, move.targetX, move.targetY);
+
+	if (result.isValid == false)
+		return false;
+
+	while (true)
+	{
+		DetectColorSequences();
+
+		if (ContainsSequences() == false)
+			break;
+
+		RemoveSequences();
+		result.clearedCells.push_back(m_Holes);
+
+		// close all holes and remember the new colors
+		CompactColors(m_CascadeMoves);
+
+		for (const DropMove& dropMove : m_CascadeMoves)
+		{
+			if (dropMove.isSpawned)
+				result.spawnedColors.push_back((uint8_t)m_Colors[dropMove.toRow * m_Columns + dropMove.column]);
+		}
+	}
+
+	return true;
+}
+
+void BoardModel::Print()
+{
+	// new line
+	std::cout << std::endl;
+
+	for (int y = 0; y < m_Rows; ++y)
+	{
+		for (int x = 0; x < m_Columns; ++x)
+		{
+			// print color ID of each cell
+			std::cout << std::to_string(m_Colors[y * m_Columns + x]) << " ";
+		}
+		// new line
+		std::cout << std::endl;
+	}
+}
+
+void BoardModel::SetSeed(const uint64_t& seed)
+{
+	m_RandomNumberGenerator.Seed(seed);
+}
+
+void BoardModel::SetRandomGenerator(const RandomGenerator& randomGenerator)
+{
+	m_RandomNumberGenerator = randomGenerator;
+}
+
+uint8_t const BoardModel::GetRandomColor()
+{
+	uint8_t randomColor = m_RandomNumberGenerator.NextBounded(m_ColorCount);
+	return randomColor;
+}
+
+void BoardModel::SetCellColor(const int& position, const int& color)
+{
+	if (m_Backend == Backend::Bitboard)
+	{
+		int previousColor = m_Colors[position];
+
+		// holes are not part of any mask
+		if (previousColor >= 0)
+			m_ColorMasks[previousColor].Reset(position);
+		if (color >= 0)
+			m_ColorMasks[color].Set(position);
+	}
+
+	// remember the previous color, so the change can be rolled back
+	if (m_IsJournalEnabled)
+	{
+		JournalEntry entry = { (uint32_t)position, m_Colors[position] };
+		m_Journal.push_back(entry);
+	}
+
+	// take the previous color out of the hash and add the new one
+	m_Hash ^= GetZobristKey(position, m_Colors[position]) ^ GetZobristKey(position, color);
+
+	m_Colors[position] = color;
+
+	// the lines through this cell have to be looked at again
+	MarkDirty(position);
+}
+
+void BoardModel::ExchangeCellColors(const int& sourcePosition, const int& targetPosition)
+{
+	int sourceColor = m_Colors[sourcePosition];
+	int targetColor = m_Colors[targetPosition];
+
+	// the masks of equal colors would reset the bits they just set
+	if (sourceColor == targetColor)
+		return;
+
+	if (m_Backend == Backend::Bitboard)
+	{
+		// holes are not part of any mask
+		if (sourceColor >= 0)
+		{
+			m_ColorMasks[sourceColor].Reset(sourcePosition);
+			m_ColorMasks[sourceColor].Set(targetPosition);
+		}
+		if (targetColor >= 0)
+		{
+			m_ColorMasks[targetColor].Reset(targetPosition);
+			m_ColorMasks[targetColor].Set(sourcePosition);
+		}
+	}
+
+	m_Colors[sourcePosition] = targetColor;
+	m_Colors[targetPosition] = sourceColor;
+}
+
+uint64_t BoardModel::GetZobristKey(const int& position, const int& color)
+{
+	// holes do not change the hash, so an empty board hashes to 0
+	if (color < 0)
+		return 0;
+
+	// the splitmix64 finalizer spreads each (cell, color) pair over all 64 bits,
+	// which serves as a random key per pair without storing a table for large boards
+	uint64_t key = (uint64_t)position * (uint64_t)GemColor::COUNT + (uint64_t)color + 1;
+	key *= 0x9E3779B97F4A7C15ull;
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+	return key ^ (key >> 31);
+}
+
+void BoardModel::RebuildHash()
+{
+	m_Hash = 0;
+
+	for (int i = 0; i < m_Columns * m_Rows; ++i)
+		m_Hash ^= GetZobristKey(i, m_Colors[i]);
+}
+
+void BoardModel::RebuildColorMasks()
+{
+	if (m_Backend != Backend::Bitboard)
+		return;
+
+	for (BitBoard& colorMask : m_ColorMasks)
+	{
+		colorMask.Clear();
+	}
+
+	for (int i = 0; i < m_Columns * m_Rows; ++i)
+	{
+		if (m_Colors[i] >= 0)
+			m_ColorMasks[m_Colors[i]].Set(i);
+	}
+}
+
+void BoardModel::DetectColorSequencesBitboard(const int& firstRow, const int& lastRow)
+{
+	if (firstRow > lastRow)
+		return;
+
+	// only the words that hold the rows near the changes are computed
+	size_t firstWord = (size_t)(firstRow * m_Columns) / 64;
+	size_t endWord = (size_t)((lastRow + 1) * m_Columns + 63) / 64;
+
+	for (const BitBoard& colorMask : m_ColorMasks)
+	{
+		// a horizontal sequence starts where the cell and its two right neighbours share the color
+		m_ScratchMask.Assign(colorMask, firstWord, endWord);
+		m_ScratchMask.AndShiftedDown(colorMask, 1, firstWord, endWord);
+		m_ScratchMask.AndShiftedDown(colorMask, 2, firstWord, endWord);
+		m_ScratchMask.And(m_HorizontalStartMask, firstWord, endWord);
+		m_HorizontalStarts.Or(m_ScratchMask, firstWord, endWord);
+
+		// a vertical sequence starts where the cell and the two cells below share the color
+		m_ScratchMask.Assign(colorMask, firstWord, endWord);
+		m_ScratchMask.AndShiftedDown(colorMask, m_Columns, firstWord, endWord);
+		m_ScratchMask.AndShiftedDown(colorMask, 2 * m_Columns, firstWord, endWord);
+		m_VerticalStarts.Or(m_ScratchMask, firstWord, endWord);
+	}
+
+	// expand the first cells to whole sequences, the starts in front of the range are all clear
+	m_HorizontalRuns.Assign(m_HorizontalStarts, firstWord, endWord);
+	m_HorizontalRuns.OrShiftedUp(m_HorizontalStarts, 1, firstWord, endWord);
+	m_HorizontalRuns.OrShiftedUp(m_HorizontalStarts, 2, firstWord, endWord);
+
+	m_VerticalRuns.Assign(m_VerticalStarts, firstWord, endWord);
+	m_VerticalRuns.OrShiftedUp(m_VerticalStarts, m_Columns, firstWord, endWord);
+	m_VerticalRuns.OrShiftedUp(m_VerticalStarts, 2 * m_Columns, firstWord, endWord);
+
+	// leave the starts clear for the next detection
+	m_HorizontalStarts.Clear(firstWord, endWord);
+	m_VerticalStarts.Clear(firstWord, endWord);
+
+	// report the sequences of the changed lines in the same order as the scalar scan
+	for (uint16_t y : m_DirtyRows)
+	{
+		uint32_t rowEnd = (y + 1) * m_Columns;
+
+		for (uint32_t position = m_HorizontalRuns.FindNext(y * m_Columns); position < rowEnd; position = m_HorizontalRuns.FindNext(position + 1))
+		{
+			MarkSequenceCell(position);
+
+			// call handler
+			Notify(BoardDelta::Type::SequenceFound, position % m_Columns, y, m_Colors[position]);
+		}
+	}
+
+	for (uint16_t x : m_DirtyColumns)
+	{
+		for (int y = firstRow; y <= lastRow; ++y)
+		{
+			int position = y * m_Columns + x;
+
+			if (m_VerticalRuns.Test(position))
+			{
+				MarkSequenceCell(position);
+
+				// call handler
+				Notify(BoardDelta::Type::SequenceFound, x, y, m_Colors[position]);
+			}
+		}
+	}
+}
+
+void BoardModel::MarkSequenceCell(const int& position)
+{
+	// cells where a horizontal and a vertical sequence cross are found twice
+	if (m_Backend == Backend::Bitboard)
+	{
+		if (m_SequenceMask.Test(position))
+			return;
+
+		m_SequenceMask.Set(position);
+	}
+	else
+	{
+		if (m_ColorSequences[position])
+			return;
+
+		m_ColorSequences[position] = true;
+	}
+
+	m_SequenceCells.push_back(position);
+}
+
+void BoardModel::ClearSequences()
+{
+	for (uint32_t position : m_SequenceCells)
+	{
+		if (m_Backend == Backend::Bitboard)
+			m_SequenceMask.Reset(position);
+		else
+			m_ColorSequences[position] = false;
+	}
+
+	m_SequenceCells.clear();
+}
+
+void BoardModel::MarkDirty(const int& position)
+{
+	uint16_t x = position % m_Columns;
+	uint16_t y = position / m_Columns;
+
+	if (m_IsRowDirty[y] == false)
+	{
+		m_IsRowDirty[y] = true;
+		m_DirtyRows.push_back(y);
+	}
+
+	if (m_IsColumnDirty[x] == false)
+	{
+		m_IsColumnDirty[x] = true;
+		m_DirtyColumns.push_back(x);
+	}
+}
+
+void BoardModel::MarkAllDirty()
+{
+	ClearDirtyLines();
+
+	for (uint16_t y = 0; y < m_Rows; ++y)
+	{
+		m_IsRowDirty[y] = true;
+		m_DirtyRows.push_back(y);
+	}
+
+	for (uint16_t x = 0; x < m_Columns; ++x)
+	{
+		m_IsColumnDirty[x] = true;
+		m_DirtyColumns.push_back(x);
+	}
+}
+
+void BoardModel::ClearDirtyLines()
+{
+	for (uint16_t y : m_DirtyRows)
+	{
+		m_IsRowDirty[y] = false;
+	}
+
+	for (uint16_t x : m_DirtyColumns)
+	{
+		m_IsColumnDirty[x] = false;
+	}
+
+	m_DirtyRows.clear();
+	m_DirtyColumns.clear();
+}
+
+bool BoardModel::IsPartOfSequenceBitboard(uint16_t const& cellX, uint16_t const& cellY)
+{
+	int sourceColor = m_Colors[cellY * m_Columns + cellX];
+
+	// holes never form a sequence
+	if (sourceColor < 0)
+		return false;
+
+	const BitBoard& colorMask = m_ColorMasks[sourceColor];
+	int position = cellY * m_Columns + cellX;
+
+	// look right, left and to both sides
+	if (cellX < (m_Columns - 2) && colorMask.Test(position + 1) && colorMask.Test(position + 2))
+		return true;
+	if (cellX > 1 && colorMask.Test(position - 1) && colorMask.Test(position - 2))
+		return true;
+	if (cellX > 0 && cellX < (m_Columns - 1) && colorMask.Test(position - 1) && colorMask.Test(position + 1))
+		return true;
+
+	// look down, up and to both sides
+	if (cellY < (m_Rows - 2) && colorMask.Test(position + m_Columns) && colorMask.Test(position + 2 * m_Columns))
+		return true;
+	if (cellY > 1 && colorMask.Test(position - m_Columns) && colorMask.Test(position - 2 * m_Columns))
+		return true;
+	if (cellY > 0 && cellY < (m_Rows - 1) && colorMask.Test(position - m_Columns) && colorMask.Test(position + m_Columns))
+		return true;
+
+	return false;
+}
+
+bool BoardModel::IsPartOfSequence(uint16_t const& cellX, uint16_t const& cellY)
+{
+	if (m_Backend == Backend::Bitboard)
+		return IsPartOfSequenceBitboard(cellX, cellY);
+
+	// look in all directions and check 
+
+	uint8_t sourceColor = m_Colors[cellY * m_Columns + cellX];
+
+	// look right
+	if (cellX < (m_Columns - 2))
+	{
+		if (sourceColor == m_Colors[cellY * m_Columns + cellX + 1] && sourceColor == m_Colors[cellY * m_Columns + cellX + 2])
+			return true;
+	}
+
+	// look left
+	if (cellX > 1)
+	{
+		if (sourceColor == m_Colors[cellY * m_Columns + cellX - 1] && sourceColor == m_Colors[cellY * m_Columns + cellX - 2])
+			return true;
+	}
+
+	// look left and right 1 field
+	if (cellX > 0 && cellX < (m_Columns - 1))
+	{
+		if (sourceColor == m_Colors[cellY * m_Columns + cellX - 1] && sourceColor == m_Colors[cellY * m_Columns + cellX + 1])
+			return true;
+	}
+
+	// look down
+	if (cellY < (m_Rows - 2))
+	{
+		if (sourceColor == m_Colors[(cellY + 1) * m_Columns + cellX] && sourceColor == m_Colors[(cellY + 2) * m_Columns + cellX])
+			return true;
+	}
+
+	// look up
+	if (cellY > 1)
+	{
+		if (sourceColor == m_Colors[(cellY - 1) * m_Columns + cellX] && sourceColor == m_Colors[(cellY - 2) * m_Columns + cellX])
+			return true;
+	}
+
+	// look up and down 1 field
+	if (cellY > 0 && cellY < (m_Rows - 1))
+	{
+		if (sourceColor == m_Colors[(cellY - 1) * m_Columns + cellX] && sourceColor == m_Colors[(cellY + 1) * m_Columns + cellX])
+			return true;
+	}
+
+	return false;
+}
+
+
+void BoardModel::SetRecordedDeltas(const uint32_t& typeMask)
+{
+	m_RecordedDeltaTypes = typeMask;
+}
+
+void BoardModel::Notify(const BoardDelta::Type& type, const uint16_t& column, const uint16_t& row, const int& color)
+{
+	if (m_RecordedDeltaTypes & BoardDelta::MaskOf(type))
+	{
+		BoardDelta delta = { type, column, row, (uint8_t)color };
+		m_Deltas.push_back(delta);
+	}
+
+	const std::function<void(const uint16_t&, const uint16_t&)>& handler = m_Handlers[(size_t)type];
+	if (handler)
+		handler(column, row);
+}
+
+void BoardModel::SetColorAddedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction)
+{
+	m_Handlers[(size_t)BoardDelta::Type::ColorAdded] = handlerFunction;
+}
+
+void BoardModel::SetColorRemovedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction)
+{
+	m_Handlers[(size_t)BoardDelta::Type::ColorRemoved] = handlerFunction;
+}
+
+void BoardModel::SetColorDroppedHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction)
+{
+	m_Handlers[(size_t)BoardDelta::Type::ColorDropped] = handlerFunction;
+}
+
+void BoardModel::SetSequenceFoundHandler(std::function<void(const uint16_t&, const uint16_t&)> handlerFunction)
+{
+	m_Handlers[(size_t)BoardDelta::Type::SequenceFound] = handlerFunction;
+}
+
+uint16_t const& BoardModel::GetColumns() const
+{
+	return m_Columns;
+}
+
+uint16_t const& BoardModel::GetRows() const
+{
+	return m_Rows;
+}
+
+void BoardModel::SetColorCount(const uint8_t& colorCount)
+{
+	m_ColorCount = std::max<uint8_t>(1, std::min<uint8_t>(colorCount, (uint8_t)GemColor::COUNT));
+}
+
+uint32_t const& BoardModel::GetHoles()
+{
+	return m_Holes;
+}
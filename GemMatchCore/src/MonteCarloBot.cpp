@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include "FixedBoardModel.h"
+#include "MonteCarloBot.h"
+
+namespace
+{
+	// returns 64 random bits
+	uint64_t NextSeed(RandomGenerator& randomGenerator)
+	{
+		uint64_t high = randomGenerator.Next();
+		return (high << 32) | randomGenerator.Next();
+	}
+}
+
+MonteCarloBot::Node::Node(const uint32_t& moveKey) :
+moveKey(moveKey),
+visits(0),
+totalScore(0)
+{
+}
+
+MonteCarloBot::MonteCarloBot() :
+m_TimeBudget(250),
+m_IterationLimit(0),
+m_Horizon(6),
+m_Exploration(1.0),
+m_ThreadCount(0),
+m_Columns(0),
+m_IterationCount(0),
+m_RandomGenerator(std::chrono::steady_clock::now().time_since_epoch().count())
+{
+	SetThreadCount(0);
+}
+
+MonteCarloBot::~MonteCarloBot()
+{
+}
+
+void MonteCarloBot::SetHorizon(const uint32_t& horizon)
+{
+	m_Horizon = std::max<uint32_t>(horizon, 1);
+}
+
+void MonteCarloBot::SetThreadCount(const uint32_t& threadCount)
+{
+	m_ThreadCount = threadCount;
+
+	// hardware_concurrency() may not know the answer
+	if (m_ThreadCount == 0)
+		m_ThreadCount = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+}
+
+bool MonteCarloBot::ChooseMove(const BoardModel& board, BoardModel::Move& move)
+{
+	// work on a headless copy, the board may change while the search runs
+	BoardModel root(board);
+
+	std::vector<BoardModel::Move> rootMoves;
+	root.FindMoves(rootMoves);
+
+	m_IterationCount = 0;
+
+	if (rootMoves.empty())
+		return false;
+
+	move = rootMoves[0];
+
+	if (rootMoves.size() == 1)
+		return true;
+
+	m_Columns = root.GetColumns();
+	m_Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_TimeBudget);
+
+	// the game board gets the fast rollouts
+	FixedBoardModel8x8 fixedRoot;
+	if (fixedRoot.Load(root))
+		Search(fixedRoot, rootMoves, move);
+	else
+		Search(root, rootMoves, move);
+
+	return true;
+}
+
+template <class Board>
+void MonteCarloBot::Search(const Board& root, const std::vector<BoardModel::Move>& rootMoves, BoardModel::Move& move)
+{
+	// every tree starts empty and gets its own stream of refills and rollouts
+	RandomGenerator searchGenerator(NextSeed(m_RandomGenerator));
+
+	m_Trees.resize(m_ThreadCount);
+	for (size_t i = 0; i < m_Trees.size(); ++i)
+	{
+		Tree& tree = m_Trees[i];
+		tree.nodes.clear();
+		tree.iterations = 0;
+		tree.randomGenerator = searchGenerator.GetStream((uint32_t)i);
+
+		// the root stands for no swap
+		tree.nodes.push_back(Node(0));
+	}
+
+	// the calling thread grows the first tree
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < m_Trees.size(); ++i)
+		threads.push_back(std::thread(&MonteCarloBot::GrowTree<Board>, this, std::cref(root), std::ref(m_Trees[i])));
+
+	GrowTree(root, m_Trees[0]);
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	// add up the visits of the root swaps of all trees
+	std::vector<uint64_t> visits(rootMoves.size(), 0);
+
+	for (const Tree& tree : m_Trees)
+	{
+		m_IterationCount += tree.iterations;
+
+		for (uint32_t childIndex : tree.nodes[0].children)
+		{
+			const Node& child = tree.nodes[childIndex];
+
+			for (size_t i = 0; i < rootMoves.size(); ++i)
+			{
+				if (GetMoveKey(rootMoves[i], m_Columns) == child.moveKey)
+					visits[i] += child.visits;
+			}
+		}
+	}
+
+	// the most visited swap is the most robust choice
+	move = rootMoves[std::max_element(visits.begin(), visits.end()) - visits.begin()];
+}
+
+template <class Board>
+void MonteCarloBot::GrowTree(const Board& root, Tree& tree)
+{
+	Board board(root);
+
+	while (true)
+	{
+		// replay the tree with another set of refills
+		board.CopyFrom(root);
+		board.SetRandomGenerator(RandomGenerator(NextSeed(tree.randomGenerator)));
+
+		tree.path.clear();
+		tree.path.push_back(0);
+
+		uint32_t nodeIndex = 0;
+		uint32_t playedMoves = 0;
+		uint64_t score = 0;
+		BoardModel::Move move;
+
+		// selection: follow the tree until a new swap has been added to it
+		while (playedMoves < m_Horizon)
+		{
+			board.FindMoves(tree.moves);
+			if (tree.moves.empty())
+				break;
+
+			nodeIndex = SelectChild(tree, nodeIndex, move);
+
+			board.ResolveMove(move, tree.result);
+			score += tree.result.GetScore();
+			++playedMoves;
+
+			tree.path.push_back(nodeIndex);
+
+			if (tree.nodes[nodeIndex].visits == 0)
+				break;
+		}
+
+		// rollout: random swaps up to the horizon
+		while (playedMoves < m_Horizon)
+		{
+			board.FindMoves(tree.moves);
+			if (tree.moves.empty())
+				break;
+
+			board.ResolveMove(tree.moves[tree.randomGenerator.NextBounded((uint32_t)tree.moves.size())], tree.result);
+			score += tree.result.GetScore();
+			++playedMoves;
+		}
+
+		// backpropagation: every node on the path shares the score of the whole iteration
+		for (uint32_t pathIndex : tree.path)
+		{
+			Node& node = tree.nodes[pathIndex];
+			++node.visits;
+			node.totalScore += score;
+		}
+
+		++tree.iterations;
+
+		if (m_IterationLimit > 0 && tree.iterations >= m_IterationLimit)
+			break;
+
+		if (m_TimeBudget > 0 && std::chrono::steady_clock::now() >= m_Deadline)
+			break;
+
+		if (m_TimeBudget == 0 && m_IterationLimit == 0)
+			break;
+	}
+}
+
+uint32_t MonteCarloBot::SelectChild(Tree& tree, const uint32_t& nodeIndex, BoardModel::Move& move)
+{
+	// the refills decide which swaps are valid, so only children of valid swaps take part
+	uint32_t bestChild = 0;
+	double bestValue = -1.0;
+
+	const Node& parent = tree.nodes[nodeIndex];
+
+	// the exploration term is scaled to the scores of this node
+	double scale = (parent.visits > 0) ? (double)parent.totalScore / parent.visits : 1.0;
+	double logVisits = std::log((double)std::max<uint32_t>(parent.visits, 1));
+
+	for (const BoardModel::Move& candidate : tree.moves)
+	{
+		uint32_t moveKey = GetMoveKey(candidate, m_Columns);
+
+		uint32_t childIndex = 0;
+		for (uint32_t index : tree.nodes[nodeIndex].children)
+		{
+			if (tree.nodes[index].moveKey == moveKey)
+			{
+				childIndex = index;
+				break;
+			}
+		}
+
+		// try every swap once before comparing them
+		if (childIndex == 0)
+		{
+			tree.nodes.push_back(Node(moveKey));
+
+			childIndex = (uint32_t)tree.nodes.size() - 1;
+			tree.nodes[nodeIndex].children.push_back(childIndex);
+
+			move = candidate;
+			return childIndex;
+		}
+
+		// UCB1: average score plus a bonus for rarely visited swaps
+		const Node& child = tree.nodes[childIndex];
+		double value = (double)child.totalScore / child.visits + m_Exploration * scale * std::sqrt(logVisits / child.visits);
+
+		if (value > bestValue)
+		{
+			bestValue = value;
+			bestChild = childIndex;
+			move = candidate;
+		}
+	}
+
+	return bestChild;
+}
+
+uint32_t MonteCarloBot::GetMoveKey(const BoardModel::Move& move, const uint16_t& columns)
+{
+	// the target is always right of or below the source
+	uint32_t direction = (move.targetY != move.sourceY) ? 1 : 0;
+	return ((uint32_t)move.sourceY * columns + move.sourceX) * 2 + direction;
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include "BoardModel.h"
+#include "PackedBoardPool.h"
+
+namespace
+{
+	// every cell of a word set to a hole without sequence flag
+	const uint64_t HOLE_WORD = 0x7777777777777777ull;
+	// the sequence bit of every cell of a word
+	const uint64_t SEQUENCE_WORD = 0x8888888888888888ull;
+}
+
+const uint8_t PackedBoardPool::COLOR_BITS;
+const uint8_t PackedBoardPool::HOLE;
+const uint8_t PackedBoardPool::SEQUENCE_BIT;
+const uint32_t PackedBoardPool::CELLS_PER_WORD;
+
+PackedBoardPool::PackedBoardPool(const uint8_t& columns, const uint8_t& rows, const size_t& capacity) :
+m_Columns(columns),
+m_Rows(rows),
+m_WordsPerBoard((columns * rows + CELLS_PER_WORD - 1) / CELLS_PER_WORD),
+m_BoardCount(0)
+{
+	m_Words.reserve(capacity * m_WordsPerBoard);
+}
+
+PackedBoardPool::~PackedBoardPool()
+{
+}
+
+uint32_t PackedBoardPool::Allocate()
+{
+	uint32_t board;
+
+	if (m_FreeBoards.empty() == false)
+	{
+		board = m_FreeBoards.back();
+		m_FreeBoards.pop_back();
+
+		std::fill(m_Words.begin() + board * m_WordsPerBoard, m_Words.begin() + (board + 1) * m_WordsPerBoard, HOLE_WORD);
+	}
+	else
+	{
+		board = m_BoardCount++;
+		m_Words.resize(m_Words.size() + m_WordsPerBoard, HOLE_WORD);
+	}
+
+	return board;
+}
+
+void PackedBoardPool::Free(const uint32_t& board)
+{
+	m_FreeBoards.push_back(board);
+}
+
+bool PackedBoardPool::SwapColors(const uint32_t& board, const uint8_t& sourceX, const uint8_t& sourceY, const uint8_t& targetX, const uint8_t& targetY)
+{
+	// check if source and target are on the board
+	if (sourceX >= m_Columns || sourceY >= m_Rows || targetX >= m_Columns || targetY >= m_Rows)
+		return false;
+
+	uint32_t sourceCell = sourceY * m_Columns + sourceX;
+	uint32_t targetCell = targetY * m_Columns + targetX;
+
+	uint8_t sourceValue = GetCell(board, sourceCell);
+	uint8_t targetValue = GetCell(board, targetCell);
+
+	SetCell(board, sourceCell, targetValue);
+	SetCell(board, targetCell, sourceValue);
+
+	// check if one of them is now part of a sequence
+	if (IsPartOfSequence(board, sourceX, sourceY) || IsPartOfSequence(board, targetX, targetY))
+		return true;
+
+	// reverse swap
+	SetCell(board, sourceCell, sourceValue);
+	SetCell(board, targetCell, targetValue);
+
+	return false;
+}
+
+bool PackedBoardPool::IsPartOfSequence(const uint32_t& board, const int& cellX, const int& cellY) const
+{
+	uint8_t color = GetCell(board, cellY * m_Columns + cellX) & COLOR_BITS;
+
+	// holes never form a sequence
+	if (color == HOLE)
+		return false;
+
+	// count equal colors left and right of the cell
+	int horizontalCount = 1;
+	for (int x = cellX - 1; x >= 0 && (GetCell(board, cellY * m_Columns + x) & COLOR_BITS) == color; --x)
+		++horizontalCount;
+	for (int x = cellX + 1; x < m_Columns && (GetCell(board, cellY * m_Columns + x) & COLOR_BITS) == color; ++x)
+		++horizontalCount;
+
+	if (horizontalCount >= 3)
+		return true;
+
+	// count equal colors above and below the cell
+	int verticalCount = 1;
+	for (int y = cellY - 1; y >= 0 && (GetCell(board, y * m_Columns + cellX) & COLOR_BITS) == color; --y)
+		++verticalCount;
+	for (int y = cellY + 1; y < m_Rows && (GetCell(board, y * m_Columns + cellX) & COLOR_BITS) == color; ++y)
+		++verticalCount;
+
+	return verticalCount >= 3;
+}
+
+bool PackedBoardPool::DetectColorSequences(const uint32_t& board)
+{
+	uint64_t* words = &m_Words[board * m_WordsPerBoard];
+
+	// forget the flags of the last detection
+	for (uint32_t i = 0; i < m_WordsPerBoard; ++i)
+		words[i] &= ~SEQUENCE_WORD;
+
+	bool containsSequence = false;
+
+	for (int y = 0; y < m_Rows; ++y)
+	{
+		for (int x = 0; x < m_Columns; ++x)
+		{
+			uint32_t cell = y * m_Columns + x;
+			uint8_t color = GetCell(board, cell) & COLOR_BITS;
+
+			if (color == HOLE)
+				continue;
+
+			// flag runs of three starting at this cell, longer runs get flagged by overlapping starts
+			if (x < m_Columns - 2 && (GetCell(board, cell + 1) & COLOR_BITS) == color && (GetCell(board, cell + 2) & COLOR_BITS) == color)
+			{
+				for (uint32_t i = 0; i < 3; ++i)
+					SetCell(board, cell + i, GetCell(board, cell + i) | SEQUENCE_BIT);
+				containsSequence = true;
+			}
+
+			if (y < m_Rows - 2 && (GetCell(board, cell + m_Columns) & COLOR_BITS) == color && (GetCell(board, cell + 2 * m_Columns) & COLOR_BITS) == color)
+			{
+				for (uint32_t i = 0; i < 3; ++i)
+					SetCell(board, cell + i * m_Columns, GetCell(board, cell + i * m_Columns) | SEQUENCE_BIT);
+				containsSequence = true;
+			}
+		}
+	}
+
+	return containsSequence;
+}
+
+void PackedBoardPool::Store(const uint32_t& board, BoardModel& model)
+{
+	for (uint8_t y = 0; y < m_Rows; ++y)
+	{
+		for (uint8_t x = 0; x < m_Columns; ++x)
+		{
+			// holes of the model read as 255
+			uint8_t color = model.GetColor(x, y);
+			SetCell(board, y * m_Columns + x, color == 255 ? HOLE : color);
+		}
+	}
+}
+
+void PackedBoardPool::Load(const uint32_t& board, BoardModel& model) const
+{
+	for (uint8_t y = 0; y < m_Rows; ++y)
+	{
+		for (uint8_t x = 0; x < m_Columns; ++x)
+		{
+			uint8_t color = GetCell(board, y * m_Columns + x) & COLOR_BITS;
+			model.SetColor(x, y, color == HOLE ? -1 : color);
+		}
+	}
+}
+
+void PackedBoardPool::Copy(const uint32_t& source, const uint32_t& target)
+{
+	std::copy(m_Words.begin() + source * m_WordsPerBoard, m_Words.begin() + (source + 1) * m_WordsPerBoard, m_Words.begin() + target * m_WordsPerBoard);
+}
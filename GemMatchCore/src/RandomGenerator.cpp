@@ -0,0 +1,75 @@
+#include "RandomGenerator.h"
+
+namespace
+{
+	// expands a 64 bit seed into well mixed state words (splitmix64)
+	uint64_t SplitMix(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+}
+
+RandomGenerator::RandomGenerator()
+{
+	Seed(0);
+}
+
+RandomGenerator::RandomGenerator(const uint64_t& seed)
+{
+	Seed(seed);
+}
+
+void RandomGenerator::Seed(const uint64_t& seed)
+{
+	uint64_t splitState = seed;
+
+	uint64_t first = SplitMix(splitState);
+	uint64_t second = SplitMix(splitState);
+
+	m_State[0] = (uint32_t)first;
+	m_State[1] = (uint32_t)(first >> 32);
+	m_State[2] = (uint32_t)second;
+	m_State[3] = (uint32_t)(second >> 32);
+}
+
+void RandomGenerator::Jump()
+{
+	static const uint32_t JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+	uint32_t state[4] = { 0, 0, 0, 0 };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int bit = 0; bit < 32; ++bit)
+		{
+			if (JUMP[i] & (uint32_t(1) << bit))
+			{
+				state[0] ^= m_State[0];
+				state[1] ^= m_State[1];
+				state[2] ^= m_State[2];
+				state[3] ^= m_State[3];
+			}
+			Next();
+		}
+	}
+
+	m_State[0] = state[0];
+	m_State[1] = state[1];
+	m_State[2] = state[2];
+	m_State[3] = state[3];
+}
+
+RandomGenerator RandomGenerator::GetStream(const uint32_t& streamIndex) const
+{
+	RandomGenerator stream = *this;
+
+	for (uint32_t i = 0; i < streamIndex; ++i)
+	{
+		stream.Jump();
+	}
+
+	return stream;
+}
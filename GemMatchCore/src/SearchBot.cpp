@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <thread>
+#include "SearchBot.h"
+
+namespace
+{
+	// scores are kept in fixed point, so averaging the samples keeps some precision
+	const int32_t SCORE_SCALE = 16;
+
+	// memory used for the transposition table
+	const size_t TABLE_SIZE_IN_MEGABYTES = 16;
+
+	// returns 64 random bits
+	uint64_t NextSeed(RandomGenerator& randomGenerator)
+	{
+		uint64_t high = randomGenerator.Next();
+		return (high << 32) | randomGenerator.Next();
+	}
+}
+
+SearchBot::Worker::Worker(const BoardModel& root) :
+board(root)
+{
+}
+
+SearchBot::SearchBot() :
+m_TimeBudget(250),
+m_MaxDepth(8),
+m_BeamWidth(4),
+m_SampleCount(4),
+m_ThreadCount(0),
+m_CompletedDepth(0),
+m_RandomGenerator(std::chrono::steady_clock::now().time_since_epoch().count()),
+m_Table(TABLE_SIZE_IN_MEGABYTES),
+m_HasDeadline(false),
+m_IsTimeUp(false)
+{
+	SetThreadCount(0);
+}
+
+SearchBot::~SearchBot()
+{
+}
+
+void SearchBot::SetMaxDepth(const uint8_t& maxDepth)
+{
+	m_MaxDepth = std::max<uint8_t>(maxDepth, 1);
+}
+
+void SearchBot::SetSampleCount(const uint32_t& sampleCount)
+{
+	m_SampleCount = std::max<uint32_t>(sampleCount, 1);
+}
+
+void SearchBot::SetThreadCount(const uint32_t& threadCount)
+{
+	m_ThreadCount = threadCount;
+
+	// hardware_concurrency() may not know the answer
+	if (m_ThreadCount == 0)
+		m_ThreadCount = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+}
+
+bool SearchBot::ChooseMove(const BoardModel& board, BoardModel::Move& move)
+{
+	// work on a headless copy, the board may change while the search runs
+	BoardModel root(board);
+
+	std::vector<BoardModel::Move> rootMoves;
+	root.FindMoves(rootMoves);
+
+	m_CompletedDepth = 0;
+
+	if (rootMoves.empty())
+		return false;
+
+	move = rootMoves[0];
+
+	if (rootMoves.size() == 1)
+		return true;
+
+	// every worker gets copies of the board for all plies and its own stream of refills
+	RandomGenerator searchGenerator(NextSeed(m_RandomGenerator));
+	size_t workerCount = std::min<size_t>(m_ThreadCount, rootMoves.size());
+
+	m_Workers.clear();
+	m_Workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		m_Workers.push_back(Worker(root));
+
+		Worker& worker = m_Workers.back();
+
+		// swaps are undone in O(changes) instead of copying the board for each ply
+		worker.board.SetJournalEnabled(true);
+		worker.moves.resize(m_MaxDepth + 1);
+		worker.beams.resize(m_MaxDepth + 1);
+		worker.randomGenerator = searchGenerator.GetStream((uint32_t)i);
+	}
+
+	std::vector<int32_t> values(rootMoves.size());
+
+	// the first depth always completes, so there is a move even with a tiny budget
+	m_HasDeadline = false;
+	m_IsTimeUp = false;
+	m_Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_TimeBudget);
+
+	for (uint8_t depth = 1; depth <= m_MaxDepth; ++depth)
+	{
+		SearchRoot(rootMoves, depth, values);
+
+		// results of an interrupted search are incomplete
+		if (m_IsTimeUp)
+			break;
+
+		move = rootMoves[std::max_element(values.begin(), values.end()) - values.begin()];
+		m_CompletedDepth = depth;
+
+		m_HasDeadline = m_TimeBudget > 0;
+		if (IsTimeUp())
+			break;
+	}
+
+	// the next move may be made on a board of another size
+	m_Workers.clear();
+
+	return true;
+}
+
+void SearchBot::SearchRoot(const std::vector<BoardModel::Move>& rootMoves, const uint8_t& depth, std::vector<int32_t>& values)
+{
+	// root swaps are handed out one at a time, so a worker that gets easy swaps takes more of them
+	std::atomic<size_t> nextMove(0);
+
+	auto search = [&](Worker& worker)
+	{
+		size_t index;
+		while ((index = nextMove++) < rootMoves.size() && IsTimeUp() == false)
+			values[index] = EvaluateMove(worker, 0, rootMoves[index], depth);
+	};
+
+	// the calling thread is the first worker
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < m_Workers.size(); ++i)
+		threads.push_back(std::thread(search, std::ref(m_Workers[i])));
+
+	search(m_Workers[0]);
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+int32_t SearchBot::EvaluateBoard(Worker& worker, const size_t& ply, const uint8_t& depth)
+{
+	BoardModel& board = worker.board;
+
+	// the same board may be reached by other swaps or refills
+	TranspositionTable::Entry entry;
+	if (m_Table.Probe(board.GetHash(), entry) && entry.depth >= depth)
+		return entry.value;
+
+	std::vector<BoardModel::Move>& moves = worker.moves[ply];
+	board.FindMoves(moves);
+
+	// the board gets shuffled, nothing to gain from it
+	if (moves.empty())
+		return 0;
+
+	// follow only the swaps that clear the most cells right away
+	std::vector<std::pair<int, uint16_t> >& beam = worker.beams[ply];
+	beam.clear();
+	for (size_t i = 0; i < moves.size(); ++i)
+		beam.push_back(std::make_pair(board.CountMoveMatches(moves[i]), (uint16_t)i));
+
+	size_t beamWidth = (m_BeamWidth == 0) ? beam.size() : std::min<size_t>(m_BeamWidth, beam.size());
+	std::partial_sort(beam.begin(), beam.begin() + beamWidth, beam.end(),
+		[](const std::pair<int, uint16_t>& a, const std::pair<int, uint16_t>& b) { return a.first > b.first; });
+
+	int32_t bestValue = 0;
+	uint16_t bestMove = beam[0].second;
+
+	for (size_t i = 0; i < beamWidth; ++i)
+	{
+		int32_t value = EvaluateMove(worker, ply, moves[beam[i].second], depth);
+		if (value > bestValue)
+		{
+			bestValue = value;
+			bestMove = beam[i].second;
+		}
+	}
+
+	// a value of an interrupted search must not be reused
+	if (IsTimeUp() == false)
+	{
+		entry.value = bestValue;
+		entry.bestMove = bestMove;
+		entry.depth = depth;
+		entry.flags = 0;
+		m_Table.Store(board.GetHash(), entry);
+	}
+
+	return bestValue;
+}
+
+int32_t SearchBot::EvaluateMove(Worker& worker, const size_t& ply, const BoardModel::Move& move, const uint8_t& depth)
+{
+	BoardModel& board = worker.board;
+	BoardModel::JournalMark mark = board.GetJournalMark();
+
+	int32_t total = 0;
+
+	for (uint32_t sample = 0; sample < m_SampleCount; ++sample)
+	{
+		if (IsTimeUp())
+			return 0;
+
+		// resolve the swap with another set of refills
+		board.SetSeed(NextSeed(worker.randomGenerator));
+
+		if (board.ResolveMove(move, worker.result) == false)
+		{
+			board.Rollback(mark);
+			return 0;
+		}
+
+		total += (int32_t)worker.result.GetScore() * SCORE_SCALE;
+
+		if (depth > 1)
+			total += EvaluateBoard(worker, ply + 1, depth - 1);
+
+		// back to the board before the swap
+		board.Rollback(mark);
+	}
+
+	return total / (int32_t)m_SampleCount;
+}
+
+bool SearchBot::IsTimeUp()
+{
+	if (m_IsTimeUp.load(std::memory_order_relaxed))
+		return true;
+
+	if (m_HasDeadline && std::chrono::steady_clock::now() >= m_Deadline)
+	{
+		m_IsTimeUp = true;
+		return true;
+	}
+
+	return false;
+}
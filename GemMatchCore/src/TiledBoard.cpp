@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "GemColor.h"
+#include "TiledBoard.h"
+
+const uint32_t TiledBoard::TILE_SIZE;
+const uint8_t TiledBoard::HOLE;
+
+TiledBoard::TiledBoard(const uint16_t& columns, const uint16_t& rows, const uint32_t& threadCount) :
+m_Columns(columns),
+m_Rows(rows),
+m_TileColumns((columns + TILE_SIZE - 1) / TILE_SIZE),
+m_TileRows((rows + TILE_SIZE - 1) / TILE_SIZE),
+m_ThreadCount(threadCount),
+m_ColorCount((uint8_t)GemColor::COUNT),
+m_Holes((uint32_t)columns * rows)
+{
+	if (m_ThreadCount == 0)
+		m_ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	// cells of partly used tiles stay holes, so runs never continue past the border
+	size_t cellCount = (size_t)m_TileColumns * m_TileRows * TILE_SIZE * TILE_SIZE;
+	m_Cells.assign(cellCount, HOLE);
+	m_SequenceFlags.assign(cellCount, 0);
+
+	// every cell of the board starts as a hole
+	m_TileHoles.assign(m_TileColumns * m_TileRows, 0);
+	for (uint32_t tileY = 0; tileY < m_TileRows; ++tileY)
+	{
+		for (uint32_t tileX = 0; tileX < m_TileColumns; ++tileX)
+		{
+			uint32_t width = std::min<uint32_t>(TILE_SIZE, m_Columns - tileX * TILE_SIZE);
+			uint32_t height = std::min<uint32_t>(TILE_SIZE, m_Rows - tileY * TILE_SIZE);
+			m_TileHoles[tileY * m_TileColumns + tileX] = width * height;
+		}
+	}
+	m_TileHasSequence.assign(m_TileColumns * m_TileRows, 0);
+	m_IsTileDirty.assign(m_TileColumns * m_TileRows, 1);
+	m_IsTileScanned.assign(m_TileColumns * m_TileRows, 0);
+	m_LowestChangedRows.assign(m_TileColumns, -1);
+	m_ColumnGenerators.resize(m_TileColumns);
+}
+
+TiledBoard::~TiledBoard()
+{
+}
+
+template <typename Function>
+void TiledBoard::ParallelFor(const uint32_t& count, const Function& function)
+{
+	uint32_t threadCount = std::min(m_ThreadCount, count);
+
+	if (threadCount <= 1)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			function(i);
+		return;
+	}
+
+	// every thread takes the next index until all are done, so slow tiles do not hold up the others
+	std::atomic<uint32_t> nextIndex(0);
+	auto work = [&nextIndex, &count, &function]()
+	{
+		for (uint32_t i = nextIndex++; i < count; i = nextIndex++)
+			function(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < threadCount; ++i)
+		threads.push_back(std::thread(work));
+
+	// the calling thread helps
+	work();
+
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+void TiledBoard::Populate(const uint64_t& seed)
+{
+	RandomGenerator randomGenerator(seed);
+	uint8_t allowedColors[(size_t)GemColor::COUNT];
+
+	// row by row, each cell avoids the colors that complete a pair to its left or above it
+	for (int y = 0; y < m_Rows; ++y)
+	{
+		for (int x = 0; x < m_Columns; ++x)
+		{
+			uint8_t leftColor = x > 1 && GetColor(x - 1, y) == GetColor(x - 2, y) ? GetColor(x - 1, y) : HOLE;
+			uint8_t upperColor = y > 1 && GetColor(x, y - 1) == GetColor(x, y - 2) ? GetColor(x, y - 1) : HOLE;
+
+			int allowedCount = 0;
+			for (uint8_t color = 0; color < m_ColorCount; ++color)
+			{
+				if (color != leftColor && color != upperColor)
+					allowedColors[allowedCount++] = color;
+			}
+
+			// a single color can not avoid sequences
+			if (allowedCount == 0)
+				SetColor(x, y, (uint8_t)randomGenerator.NextBounded(m_ColorCount));
+			else
+				SetColor(x, y, allowedColors[randomGenerator.NextBounded(allowedCount)]);
+		}
+	}
+
+	// each column of tiles continues with its own stream
+	for (uint32_t i = 0; i < m_TileColumns; ++i)
+	{
+		randomGenerator.Jump();
+		m_ColumnGenerators[i] = randomGenerator;
+	}
+}
+
+bool TiledBoard::SwapColors(const uint16_t& sourceX, const uint16_t& sourceY, const uint16_t& targetX, const uint16_t& targetY)
+{
+	if (sourceX >= m_Columns || sourceY >= m_Rows || targetX >= m_Columns || targetY >= m_Rows)
+		return false;
+
+	uint8_t& source = m_Cells[GetCellIndex(sourceX, sourceY)];
+	uint8_t& target = m_Cells[GetCellIndex(targetX, targetY)];
+
+	std::swap(source, target);
+
+	if (IsPartOfSequence(sourceX, sourceY) || IsPartOfSequence(targetX, targetY))
+	{
+		m_IsTileDirty[(sourceY / TILE_SIZE) * m_TileColumns + sourceX / TILE_SIZE] = 1;
+		m_IsTileDirty[(targetY / TILE_SIZE) * m_TileColumns + targetX / TILE_SIZE] = 1;
+		return true;
+	}
+
+	std::swap(source, target);
+	return false;
+}
+
+bool TiledBoard::IsPartOfSequence(const int& cellX, const int& cellY) const
+{
+	uint8_t color = m_Cells[GetCellIndex(cellX, cellY)];
+
+	// holes never form a sequence
+	if (color == HOLE)
+		return false;
+
+	// the three horizontal windows that contain the cell
+	bool left1 = cellX > 0 && m_Cells[GetCellIndex(cellX - 1, cellY)] == color;
+	bool left2 = left1 && cellX > 1 && m_Cells[GetCellIndex(cellX - 2, cellY)] == color;
+	bool right1 = cellX < m_Columns - 1 && m_Cells[GetCellIndex(cellX + 1, cellY)] == color;
+	bool right2 = right1 && cellX < m_Columns - 2 && m_Cells[GetCellIndex(cellX + 2, cellY)] == color;
+
+	if (left2 || right2 || (left1 && right1))
+		return true;
+
+	// the three vertical windows
+	bool up1 = cellY > 0 && m_Cells[GetCellIndex(cellX, cellY - 1)] == color;
+	bool up2 = up1 && cellY > 1 && m_Cells[GetCellIndex(cellX, cellY - 2)] == color;
+	bool down1 = cellY < m_Rows - 1 && m_Cells[GetCellIndex(cellX, cellY + 1)] == color;
+	bool down2 = down1 && cellY < m_Rows - 2 && m_Cells[GetCellIndex(cellX, cellY + 2)] == color;
+
+	return up2 || down2 || (up1 && down1);
+}
+
+bool TiledBoard::DetectColorSequences()
+{
+	// a cell only depends on cells up to two steps away, so a tile needs a scan if it or a direct neighbour changed.
+	// any other tile had no sequence before and still has none
+	for (uint32_t tileY = 0; tileY < m_TileRows; ++tileY)
+	{
+		for (uint32_t tileX = 0; tileX < m_TileColumns; ++tileX)
+		{
+			uint32_t tile = tileY * m_TileColumns + tileX;
+
+			m_IsTileScanned[tile] = m_IsTileDirty[tile] ||
+				(tileX > 0 && m_IsTileDirty[tile - 1]) ||
+				(tileX < m_TileColumns - 1 && m_IsTileDirty[tile + 1]) ||
+				(tileY > 0 && m_IsTileDirty[tile - m_TileColumns]) ||
+				(tileY < m_TileRows - 1 && m_IsTileDirty[tile + m_TileColumns]);
+		}
+	}
+	std::fill(m_IsTileDirty.begin(), m_IsTileDirty.end(), 0);
+
+	ParallelFor(m_TileColumns * m_TileRows, [this](uint32_t tile)
+	{
+		if (m_IsTileScanned[tile] == 0)
+		{
+			m_TileHasSequence[tile] = 0;
+			return;
+		}
+
+		uint32_t tileX = tile % m_TileColumns;
+		uint32_t tileY = tile / m_TileColumns;
+
+		const uint8_t* cells = &m_Cells[(size_t)tile * TILE_SIZE * TILE_SIZE];
+		uint8_t* flags = &m_SequenceFlags[(size_t)tile * TILE_SIZE * TILE_SIZE];
+		uint8_t hasSequence = 0;
+
+		for (uint32_t y = 0; y < TILE_SIZE; ++y)
+		{
+			for (uint32_t x = 0; x < TILE_SIZE; ++x)
+			{
+				uint32_t i = y * TILE_SIZE + x;
+				uint8_t color = cells[i];
+				uint8_t isSequence = 0;
+
+				if (color == HOLE)
+				{
+					// nothing to find, this includes the unused cells of border tiles
+				}
+				else if (x >= 2 && x < TILE_SIZE - 2 && y >= 2 && y < TILE_SIZE - 2)
+				{
+					// all windows lie inside the tile
+					isSequence =
+						(cells[i - 1] == color && (cells[i - 2] == color || cells[i + 1] == color)) ||
+						(cells[i + 1] == color && cells[i + 2] == color) ||
+						(cells[i - TILE_SIZE] == color && (cells[i - 2 * TILE_SIZE] == color || cells[i + TILE_SIZE] == color)) ||
+						(cells[i + TILE_SIZE] == color && cells[i + 2 * TILE_SIZE] == color);
+				}
+				else
+				{
+					// the windows reach into neighbouring tiles, which are only read
+					isSequence = IsPartOfSequence(tileX * TILE_SIZE + x, tileY * TILE_SIZE + y);
+				}
+
+				flags[i] = isSequence;
+				hasSequence |= isSequence;
+			}
+		}
+
+		m_TileHasSequence[tile] = hasSequence;
+	});
+
+	return std::find(m_TileHasSequence.begin(), m_TileHasSequence.end(), 1) != m_TileHasSequence.end();
+}
+
+uint32_t TiledBoard::RemoveSequences()
+{
+	ParallelFor(m_TileColumns * m_TileRows, [this](uint32_t tile)
+	{
+		// tiles without sequence have nothing to clear, holes they already have stay counted
+		if (m_TileHasSequence[tile] == 0)
+			return;
+
+		uint8_t* cells = &m_Cells[(size_t)tile * TILE_SIZE * TILE_SIZE];
+		const uint8_t* flags = &m_SequenceFlags[(size_t)tile * TILE_SIZE * TILE_SIZE];
+		uint32_t holes = 0;
+
+		for (uint32_t i = 0; i < TILE_SIZE * TILE_SIZE; ++i)
+		{
+			holes += flags[i];
+			cells[i] = flags[i] ? HOLE : cells[i];
+		}
+
+		m_TileHoles[tile] += holes;
+	});
+
+	// flagged cells are never holes, so every new hole is a cleared cell
+	uint32_t previousHoles = m_Holes;
+
+	m_Holes = 0;
+	for (size_t i = 0; i < m_TileHoles.size(); ++i)
+		m_Holes += m_TileHoles[i];
+
+	return m_Holes - previousHoles;
+}
+
+void TiledBoard::DropColors()
+{
+	ParallelFor(m_TileColumns, [this](uint32_t tileX)
+	{
+		m_LowestChangedRows[tileX] = -1;
+
+		// columns of tiles without holes stay as they are
+		bool hasHoles = false;
+		for (uint32_t tileY = 0; tileY < m_TileRows && hasHoles == false; ++tileY)
+			hasHoles = m_TileHoles[tileY * m_TileColumns + tileX] > 0;
+
+		if (hasHoles == false)
+			return;
+
+		RandomGenerator& randomGenerator = m_ColumnGenerators[tileX];
+		uint32_t lastColumn = std::min<uint32_t>((tileX + 1) * TILE_SIZE, m_Columns);
+		int lowestChangedRow = -1;
+
+		for (uint32_t x = tileX * TILE_SIZE; x < lastColumn; ++x)
+		{
+			// the lowest cell that has not been settled yet
+			int targetRow = m_Rows - 1;
+
+			for (int y = m_Rows - 1; y >= 0; --y)
+			{
+				uint8_t color = m_Cells[GetCellIndex(x, y)];
+
+				if (color != HOLE)
+				{
+					if (y != targetRow)
+						m_Cells[GetCellIndex(x, targetRow)] = color;
+
+					--targetRow;
+				}
+				else
+				{
+					// every cell from the lowest hole up changes
+					lowestChangedRow = std::max(lowestChangedRow, y);
+				}
+			}
+
+			// fill the cells above with new colors
+			for (int y = targetRow; y >= 0; --y)
+				m_Cells[GetCellIndex(x, y)] = (uint8_t)randomGenerator.NextBounded(m_ColorCount);
+		}
+
+		m_LowestChangedRows[tileX] = lowestChangedRow;
+
+		// the whole column of tiles is settled now
+		for (uint32_t tileY = 0; tileY < m_TileRows; ++tileY)
+			m_TileHoles[tileY * m_TileColumns + tileX] = 0;
+	});
+
+	// mark the tiles that changed, rows below the lowest hole keep their colors
+	for (uint32_t tileX = 0; tileX < m_TileColumns; ++tileX)
+	{
+		if (m_LowestChangedRows[tileX] < 0)
+			continue;
+
+		for (uint32_t tileY = 0; tileY <= (uint32_t)m_LowestChangedRows[tileX] / TILE_SIZE; ++tileY)
+			m_IsTileDirty[tileY * m_TileColumns + tileX] = 1;
+	}
+
+	m_Holes = 0;
+}
+
+uint32_t TiledBoard::ResolveCascades()
+{
+	uint32_t chainDepth = 0;
+
+	while (DetectColorSequences())
+	{
+		RemoveSequences();
+		DropColors();
+		++chainDepth;
+	}
+
+	return chainDepth;
+}
+
+void TiledBoard::SetColorCount(const uint8_t& colorCount)
+{
+	m_ColorCount = std::max<uint8_t>(1, std::min<uint8_t>(colorCount, (uint8_t)GemColor::COUNT));
+}
@@ -0,0 +1,78 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(const size_t& sizeInMegabytes)
+{
+	// the largest power of two amount of slots that fits, at least one
+	size_t maxSlots = sizeInMegabytes * 1024 * 1024 / sizeof(Slot);
+	m_Capacity = 1;
+	while (m_Capacity * 2 <= maxSlots)
+		m_Capacity *= 2;
+
+	m_IndexMask = m_Capacity - 1;
+	m_Slots = new Slot[m_Capacity];
+
+	Clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+	delete[] m_Slots;
+}
+
+bool TranspositionTable::Probe(const uint64_t& hash, Entry& entry) const
+{
+	const Slot& slot = m_Slots[hash & m_IndexMask];
+
+	uint64_t check = slot.check.load(std::memory_order_relaxed);
+	uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+	// another board, an empty slot or a slot that is being written
+	if ((check ^ data) != hash)
+		return false;
+
+	entry = Unpack(data);
+	return true;
+}
+
+void TranspositionTable::Store(const uint64_t& hash, const Entry& entry)
+{
+	Slot& slot = m_Slots[hash & m_IndexMask];
+
+	// keep deeper results of the same board, a racing writer may slip in between, which costs only a result
+	uint64_t check = slot.check.load(std::memory_order_relaxed);
+	uint64_t data = slot.data.load(std::memory_order_relaxed);
+	if ((check ^ data) == hash && Unpack(data).depth > entry.depth)
+		return;
+
+	uint64_t packed = Pack(entry);
+	slot.check.store(hash ^ packed, std::memory_order_relaxed);
+	slot.data.store(packed, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear()
+{
+	// zeroed slots would match hash 0, the empty board, so empty slots match the hash with all bits set instead
+	for (size_t i = 0; i < m_Capacity; ++i)
+	{
+		m_Slots[i].check.store(~uint64_t(0), std::memory_order_relaxed);
+		m_Slots[i].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+uint64_t TranspositionTable::Pack(const Entry& entry)
+{
+	return (uint64_t)(uint32_t)entry.value |
+		((uint64_t)entry.bestMove << 32) |
+		((uint64_t)entry.depth << 48) |
+		((uint64_t)entry.flags << 56);
+}
+
+TranspositionTable::Entry TranspositionTable::Unpack(const uint64_t& data)
+{
+	Entry entry;
+	entry.value = (int32_t)(uint32_t)(data & 0xFFFFFFFF);
+	entry.bestMove = (uint16_t)(data >> 32);
+	entry.depth = (uint8_t)(data >> 48);
+	entry.flags = (uint8_t)(data >> 56);
+	return entry;
+}
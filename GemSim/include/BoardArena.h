@@ -0,0 +1,56 @@
+#ifndef __BOARD_ARENA_H__
+#define __BOARD_ARENA_H__
+
+#include <cstdint>
+#include <vector>
+#include "BoardModel.h"
+
+/*! A set of preallocated boards of the same size that get reused instead of constructed
+*
+*	Each worker owns its own arena, so acquiring and releasing boards needs no locking.
+*/
+class BoardArena
+{
+public:
+	/*! \brief Allocates the boards up front
+	*
+	*	\param columns Width of every board
+	*	\param rows Height of every board
+	*	\param colorCount Amount of colors drawn by every board
+	*	\param capacity Amount of boards allocated immediately
+	*/
+	BoardArena(const uint16_t& columns, const uint16_t& rows, const uint8_t& colorCount, const size_t& capacity);
+	virtual ~BoardArena();
+
+	/*! \brief Hands out an empty board
+	*
+	*	The board is reset in place. A new board is only allocated when all boards are in use.
+	*
+	*	\return The board, owned by the arena until it gets released
+	*/
+	BoardModel* Acquire();
+
+	/*! \brief Returns a board to the arena
+	*
+	*	\param board A board acquired from this arena
+	*/
+	void Release(BoardModel* board);
+
+	// returns amount of boards owned by the arena
+	size_t GetCapacity() const { return m_Boards.size(); }
+
+private:
+	/*! \brief Allocates another board and adds it to the free boards */
+	void Grow();
+
+	const uint16_t m_Columns;
+	const uint16_t m_Rows;
+	const uint8_t m_ColorCount;
+
+	// every board of the arena
+	std::vector<BoardModel*> m_Boards;
+	// boards that are not in use
+	std::vector<BoardModel*> m_FreeBoards;
+};
+
+#endif
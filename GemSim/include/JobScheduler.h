@@ -0,0 +1,85 @@
+#ifndef __JOB_SCHEDULER_H__
+#define __JOB_SCHEDULER_H__
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+/*! Runs jobs on a fixed set of workers that steal from each other
+*
+*	Every worker owns a queue. It takes its newest job first, which keeps its data in cache,
+*	and an idle worker steals the oldest job of another worker. Long and short jobs can be mixed
+*	without leaving cores idle at the end of a batch.
+*/
+class JobScheduler
+{
+public:
+	/*! A job receives the index of the worker that runs it, e.g. to pick per-worker data */
+	typedef std::function<void(uint32_t)> Job;
+
+	/*! \brief Starts the workers
+	*
+	*	\param threadCount Amount of workers, 0 uses one worker per hardware thread
+	*/
+	JobScheduler(const uint32_t& threadCount);
+	virtual ~JobScheduler();
+
+	/*! \brief Queues a job
+	*
+	*	Jobs submitted by a worker go to its own queue, other threads spread their jobs over all queues.
+	*
+	*	\param job The function to run on a worker
+	*/
+	void Submit(const Job& job);
+
+	/*! Blocks until every submitted job has finished */
+	void Wait();
+
+	// returns amount of workers
+	uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size(); }
+
+private:
+	/*! The queue of a single worker, the owner uses the back, thieves the front */
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	/*! \brief Runs jobs until the scheduler shuts down
+	*
+	*	\param workerIndex The index of the worker and its queue
+	*/
+	void Work(const uint32_t& workerIndex);
+
+	/*! \brief Takes a job from the own queue or steals one from another worker
+	*
+	*	\param workerIndex The index of the worker looking for work
+	*	\param job Receives the job
+	*	\return false if all queues are empty
+	*/
+	bool FindJob(const uint32_t& workerIndex, Job& job);
+
+	std::vector<std::thread> m_Workers;
+	std::vector<WorkerQueue*> m_Queues;
+
+	// queue that receives the next job submitted from outside
+	std::atomic<uint32_t> m_NextQueue;
+	// amount of jobs that are queued or running
+	std::atomic<uint64_t> m_PendingJobs;
+	// amount of jobs that are queued
+	std::atomic<uint64_t> m_QueuedJobs;
+
+	// idle workers and Wait() sleep on this mutex
+	std::mutex m_SleepMutex;
+	std::condition_variable m_JobAvailable;
+	std::condition_variable m_AllJobsFinished;
+	bool m_IsStopping;
+};
+
+#endif
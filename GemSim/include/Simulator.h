@@ -0,0 +1,169 @@
+#ifndef __SIMULATOR_H__
+#define __SIMULATOR_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+#include "BoardModel.h"
+
+class BoardArena;
+class JobScheduler;
+
+/*! \brief The way a simulated player picks its next move
+*
+*	Random picks any valid swap, Greedy the swap that clears the most cells in its first step,
+*	Scripted replays a list of swaps in order.
+*/
+enum class Policy { Random, Greedy, Scripted };
+
+/*! Parameters of a simulation run */
+struct SimulationSettings
+{
+	SimulationSettings();
+
+	// amount of games to play
+	uint64_t games;
+	// amount of moves after which a game ends
+	uint32_t movesPerGame;
+	// amount of worker threads, 0 uses one per hardware thread
+	uint32_t threads;
+	Policy policy;
+	// swaps replayed by the scripted policy
+	std::vector<BoardModel::Move> script;
+	uint16_t columns;
+	uint16_t rows;
+	// amount of gem colors in play
+	uint8_t colors;
+	// base seed, every game derives its own seed from it
+	uint64_t seed;
+};
+
+/*! Counts how often each value occurred
+*
+*/
+class Histogram
+{
+public:
+	Histogram();
+	virtual ~Histogram();
+
+	/*! \brief Counts a single occurrence of a value
+	*
+	*	\param value The observed value
+	*/
+	void Add(const size_t& value);
+
+	/*! \brief Adds the counts of another histogram to this one
+	*
+	*	\param other The histogram to add
+	*/
+	void Merge(const Histogram& other);
+
+	// returns amount of recorded values
+	uint64_t GetCount() const { return m_Count; }
+
+	// returns the average of the recorded values
+	double GetMean() const;
+
+	/*! \brief Prints the mean and the share of each value
+	*
+	*	\param stream The stream to print to
+	*	\param title The name printed in front of the histogram
+	*/
+	void Print(std::ostream& stream, const std::string& title) const;
+
+private:
+	// occurrences indexed by value
+	std::vector<uint64_t> m_Buckets;
+	uint64_t m_Count;
+	uint64_t m_Sum;
+};
+
+/*! Results of a simulation run */
+struct SimulationReport
+{
+	SimulationReport();
+
+	/*! \brief Adds the results of another report to this one
+	*
+	*	\param other The report to add, its duration is ignored
+	*/
+	void Merge(const SimulationReport& other);
+
+	/*! \brief Prints throughput and distributions
+	*
+	*	\param stream The stream to print to
+	*/
+	void Print(std::ostream& stream) const;
+
+	uint64_t games;
+	// amount of resolved moves
+	uint64_t moves;
+	// amount of clear steps, a move with a chain of three counts three times
+	uint64_t cascades;
+	// wall clock duration of the run
+	double seconds;
+
+	// chain depth of each move
+	Histogram chainDepths;
+	// cells cleared by each move
+	Histogram clearedCells;
+	// boards without a valid move in each game
+	Histogram deadEnds;
+};
+
+/*! Plays many complete games with BoardModel on a work-stealing scheduler
+*
+*/
+class Simulator
+{
+public:
+	Simulator(const SimulationSettings& settings);
+	virtual ~Simulator();
+
+	/*! \brief Plays all games and collects their results
+	*
+	*	Every game gets its own seed, so a run is reproducible regardless of the thread count.
+	*
+	*	\param report Receives the merged results
+	*/
+	void Run(SimulationReport& report);
+
+private:
+	/*! \brief Plays a range of games, splitting it into jobs other workers can steal
+	*
+	*	\param firstGame The index of the first game
+	*	\param lastGame The index after the last game
+	*	\param scheduler The scheduler that receives the split off halves
+	*	\param workerIndex The worker that runs the range
+	*/
+	void PlayGames(const uint64_t& firstGame, const uint64_t& lastGame, JobScheduler& scheduler, const uint32_t& workerIndex);
+
+	/*! \brief Plays a single game
+	*
+	*	\param gameIndex The index of the game, used to derive its seed
+	*	\param board The board to play on, gets populated
+	*	\param report Receives the results of the game
+	*/
+	void PlayGame(const uint64_t& gameIndex, BoardModel& board, SimulationReport& report);
+
+	/*! \brief Picks the next move according to the policy
+	*
+	*	\param board The board the move is played on
+	*	\param moves The valid moves of the board, never empty
+	*	\param turn The index of the move within the game
+	*	\param randomGenerator The generator of the player
+	*	\return The move to play
+	*/
+	const BoardModel::Move& ChooseMove(BoardModel& board, const std::vector<BoardModel::Move>& moves, const uint32_t& turn, RandomGenerator& randomGenerator);
+
+	SimulationSettings m_Settings;
+
+	// boards of each worker, only used during Run()
+	std::vector<BoardArena*> m_Arenas;
+	// results of each worker, merged at the end of Run()
+	std::vector<SimulationReport> m_WorkerReports;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "BoardArena.h"
+
+BoardArena::BoardArena(const uint16_t& columns, const uint16_t& rows, const uint8_t& colorCount, const size_t& capacity) :
+m_Columns(columns),
+m_Rows(rows),
+m_ColorCount(colorCount)
+{
+	m_Boards.reserve(capacity);
+	m_FreeBoards.reserve(capacity);
+
+	for (size_t i = 0; i < capacity; ++i)
+		Grow();
+}
+
+BoardArena::~BoardArena()
+{
+	for (size_t i = 0; i < m_Boards.size(); ++i)
+		delete m_Boards[i];
+
+	m_Boards.clear();
+	m_FreeBoards.clear();
+}
+
+BoardModel* BoardArena::Acquire()
+{
+	if (m_FreeBoards.empty())
+		Grow();
+
+	BoardModel* board = m_FreeBoards.back();
+	m_FreeBoards.pop_back();
+
+	board->Reset();
+	return board;
+}
+
+void BoardArena::Release(BoardModel* board)
+{
+	m_FreeBoards.push_back(board);
+}
+
+void BoardArena::Grow()
+{
+	BoardModel* board = new BoardModel(m_Columns, m_Rows, BoardModel::Backend::Bitboard);
+	board->SetColorCount(m_ColorCount);
+
+	m_Boards.push_back(board);
+	m_FreeBoards.push_back(board);
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include "JobScheduler.h"
+
+namespace
+{
+	// marks a thread that is not one of the workers
+	const uint32_t NO_WORKER = UINT32_MAX;
+}
+
+JobScheduler::JobScheduler(const uint32_t& threadCount) :
+m_NextQueue(0),
+m_PendingJobs(0),
+m_QueuedJobs(0),
+m_IsStopping(false)
+{
+	uint32_t workerCount = threadCount;
+	if (workerCount == 0)
+		workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+	// all queues exist before the first worker starts stealing
+	for (uint32_t i = 0; i < workerCount; ++i)
+		m_Queues.push_back(new WorkerQueue());
+
+	for (uint32_t i = 0; i < workerCount; ++i)
+		m_Workers.push_back(std::thread(&JobScheduler::Work, this, i));
+}
+
+JobScheduler::~JobScheduler()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+		m_IsStopping = true;
+	}
+	m_JobAvailable.notify_all();
+
+	for (size_t i = 0; i < m_Workers.size(); ++i)
+		m_Workers[i].join();
+
+	for (size_t i = 0; i < m_Queues.size(); ++i)
+		delete m_Queues[i];
+}
+
+void JobScheduler::Submit(const Job& job)
+{
+	// jobs submitted by a worker stay on its queue, everything else is spread round robin
+	uint32_t queueIndex = NO_WORKER;
+	std::thread::id threadId = std::this_thread::get_id();
+	for (uint32_t i = 0; i < m_Workers.size(); ++i)
+	{
+		if (m_Workers[i].get_id() == threadId)
+		{
+			queueIndex = i;
+			break;
+		}
+	}
+	if (queueIndex == NO_WORKER)
+		queueIndex = m_NextQueue++ % m_Queues.size();
+
+	// count the job first, so it is never taken before it is counted
+	++m_PendingJobs;
+	++m_QueuedJobs;
+	{
+		std::lock_guard<std::mutex> lock(m_Queues[queueIndex]->mutex);
+		m_Queues[queueIndex]->jobs.push_back(job);
+	}
+
+	// take the lock so that a worker that is about to sleep does not miss the job
+	{
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+	}
+	m_JobAvailable.notify_one();
+}
+
+void JobScheduler::Wait()
+{
+	std::unique_lock<std::mutex> lock(m_SleepMutex);
+	while (m_PendingJobs > 0)
+		m_AllJobsFinished.wait(lock);
+}
+
+void JobScheduler::Work(const uint32_t& workerIndex)
+{
+	Job job;
+
+	for (;;)
+	{
+		if (FindJob(workerIndex, job))
+		{
+			job(workerIndex);
+			job = nullptr;
+
+			if (--m_PendingJobs == 0)
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				m_AllJobsFinished.notify_all();
+			}
+			continue;
+		}
+
+		// nothing to run or steal, sleep until a job gets submitted
+		std::unique_lock<std::mutex> lock(m_SleepMutex);
+		while (m_QueuedJobs == 0 && m_IsStopping == false)
+			m_JobAvailable.wait(lock);
+
+		if (m_QueuedJobs == 0 && m_IsStopping)
+			return;
+	}
+}
+
+bool JobScheduler::FindJob(const uint32_t& workerIndex, Job& job)
+{
+	// newest job of the own queue first
+	{
+		WorkerQueue& queue = *m_Queues[workerIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty() == false)
+		{
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+			--m_QueuedJobs;
+			return true;
+		}
+	}
+
+	// steal the oldest job of the next worker that has one
+	for (size_t offset = 1; offset < m_Queues.size(); ++offset)
+	{
+		WorkerQueue& queue = *m_Queues[(workerIndex + offset) % m_Queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty() == false)
+		{
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+			--m_QueuedJobs;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include "GemColor.h"
+#include "BoardArena.h"
+#include "JobScheduler.h"
+#include "Simulator.h"
+
+namespace
+{
+	// ranges of up to this many games are played by one job instead of being split further
+	const uint64_t GAMES_PER_JOB = 8;
+}
+
+SimulationSettings::SimulationSettings() :
+games(1000),
+movesPerGame(100),
+threads(0),
+policy(Policy::Random),
+columns(8),
+rows(8),
+colors((uint8_t)GemColor::COUNT),
+seed(1)
+{
+}
+
+Histogram::Histogram() :
+m_Count(0),
+m_Sum(0)
+{
+}
+
+Histogram::~Histogram()
+{
+}
+
+void Histogram::Add(const size_t& value)
+{
+	if (value >= m_Buckets.size())
+		m_Buckets.resize(value + 1, 0);
+
+	++m_Buckets[value];
+	++m_Count;
+	m_Sum += value;
+}
+
+void Histogram::Merge(const Histogram& other)
+{
+	if (other.m_Buckets.size() > m_Buckets.size())
+		m_Buckets.resize(other.m_Buckets.size(), 0);
+
+	for (size_t i = 0; i < other.m_Buckets.size(); ++i)
+		m_Buckets[i] += other.m_Buckets[i];
+
+	m_Count += other.m_Count;
+	m_Sum += other.m_Sum;
+}
+
+double Histogram::GetMean() const
+{
+	if (m_Count == 0)
+		return 0.0;
+
+	return (double)m_Sum / m_Count;
+}
+
+void Histogram::Print(std::ostream& stream, const std::string& title) const
+{
+	stream << title << ": mean " << std::fixed << std::setprecision(3) << GetMean() << std::endl;
+
+	for (size_t value = 0; value < m_Buckets.size(); ++value)
+	{
+		if (m_Buckets[value] == 0)
+			continue;
+
+		stream << "  " << std::setw(4) << value << ": " << std::setw(12) << m_Buckets[value]
+			<< " (" << std::setprecision(2) << 100.0 * m_Buckets[value] / m_Count << "%)" << std::endl;
+	}
+}
+
+SimulationReport::SimulationReport() :
+games(0),
+moves(0),
+cascades(0),
+seconds(0.0)
+{
+}
+
+void SimulationReport::Merge(const SimulationReport& other)
+{
+	games += other.games;
+	moves += other.moves;
+	cascades += other.cascades;
+
+	chainDepths.Merge(other.chainDepths);
+	clearedCells.Merge(other.clearedCells);
+	deadEnds.Merge(other.deadEnds);
+}
+
+void SimulationReport::Print(std::ostream& stream) const
+{
+	double duration = std::max(seconds, 1e-9);
+
+	stream << "games:       " << games << std::endl;
+	stream << "moves:       " << moves << std::endl;
+	stream << "cascades:    " << cascades << std::endl;
+	stream << "seconds:     " << std::fixed << std::setprecision(3) << seconds << std::endl;
+	stream << "moves/s:     " << std::setprecision(0) << moves / duration << std::endl;
+	stream << "cascades/s:  " << cascades / duration << std::endl;
+
+	chainDepths.Print(stream, "chain depth per move");
+	clearedCells.Print(stream, "cleared cells per move");
+	deadEnds.Print(stream, "dead ends per game");
+}
+
+Simulator::Simulator(const SimulationSettings& settings) :
+m_Settings(settings)
+{
+}
+
+Simulator::~Simulator()
+{
+}
+
+void Simulator::Run(SimulationReport& report)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	JobScheduler scheduler(m_Settings.threads);
+
+	// every worker gets its own boards and results, so games never wait for each other
+	m_Arenas.clear();
+	m_WorkerReports.assign(scheduler.GetThreadCount(), SimulationReport());
+	for (uint32_t i = 0; i < scheduler.GetThreadCount(); ++i)
+		m_Arenas.push_back(new BoardArena(m_Settings.columns, m_Settings.rows, m_Settings.colors, 1));
+
+	scheduler.Submit([this, &scheduler](uint32_t workerIndex)
+	{
+		PlayGames(0, m_Settings.games, scheduler, workerIndex);
+	});
+	scheduler.Wait();
+
+	for (size_t i = 0; i < m_WorkerReports.size(); ++i)
+		report.Merge(m_WorkerReports[i]);
+
+	for (size_t i = 0; i < m_Arenas.size(); ++i)
+		delete m_Arenas[i];
+	m_Arenas.clear();
+	m_WorkerReports.clear();
+
+	report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Simulator::PlayGames(const uint64_t& firstGame, const uint64_t& lastGame, JobScheduler& scheduler, const uint32_t& workerIndex)
+{
+	// split off the upper half until the range is small, idle workers steal the halves
+	uint64_t end = lastGame;
+	while (end - firstGame > GAMES_PER_JOB)
+	{
+		uint64_t middle = firstGame + (end - firstGame) / 2;
+		uint64_t upperEnd = end;
+
+		scheduler.Submit([this, middle, upperEnd, &scheduler](uint32_t stealingWorker)
+		{
+			PlayGames(middle, upperEnd, scheduler, stealingWorker);
+		});
+
+		end = middle;
+	}
+
+	BoardArena& arena = *m_Arenas[workerIndex];
+	SimulationReport& report = m_WorkerReports[workerIndex];
+
+	for (uint64_t game = firstGame; game < end; ++game)
+	{
+		BoardModel* board = arena.Acquire();
+		PlayGame(game, *board, report);
+		arena.Release(board);
+	}
+}
+
+void Simulator::PlayGame(const uint64_t& gameIndex, BoardModel& board, SimulationReport& report)
+{
+	// the game index selects the seed, so the result does not depend on the thread that plays it
+	board.SetSeed((m_Settings.seed << 32) ^ gameIndex);
+	board.Populate();
+
+	// the player draws from its own stream, so its choices do not change the colors that spawn
+	RandomGenerator playerGenerator = board.GetRandomGenerator().GetStream(1);
+
+	std::vector<BoardModel::Move> moves;
+	BoardModel::CascadeResult result;
+	size_t deadEnds = 0;
+
+	for (uint32_t turn = 0; turn < m_Settings.movesPerGame; ++turn)
+	{
+		board.FindMoves(moves);
+		if (moves.empty())
+		{
+			++deadEnds;
+			board.Shuffle();
+
+			board.FindMoves(moves);
+			// boards that are too small for any move end the game
+			if (moves.empty())
+				break;
+		}
+
+		if (board.ResolveMove(ChooseMove(board, moves, turn, playerGenerator), result) == false)
+			continue;
+
+		report.moves++;
+		report.cascades += result.GetChainDepth();
+		report.chainDepths.Add(result.GetChainDepth());
+
+		size_t clearedCells = 0;
+		for (size_t i = 0; i < result.clearedCells.size(); ++i)
+			clearedCells += result.clearedCells[i];
+		report.clearedCells.Add(clearedCells);
+	}
+
+	report.games++;
+	report.deadEnds.Add(deadEnds);
+}
+
+const BoardModel::Move& Simulator::ChooseMove(BoardModel& board, const std::vector<BoardModel::Move>& moves, const uint32_t& turn, RandomGenerator& randomGenerator)
+{
+	switch (m_Settings.policy)
+	{
+	case Policy::Greedy:
+	{
+		size_t bestIndex = 0;
+		int bestCount = -1;
+		for (size_t i = 0; i < moves.size(); ++i)
+		{
+			int count = board.CountMoveMatches(moves[i]);
+			if (count > bestCount)
+			{
+				bestCount = count;
+				bestIndex = i;
+			}
+		}
+		return moves[bestIndex];
+	}
+	case Policy::Scripted:
+	{
+		if (m_Settings.script.empty() == false)
+		{
+			const BoardModel::Move& scripted = m_Settings.script[turn % m_Settings.script.size()];
+			for (size_t i = 0; i < moves.size(); ++i)
+			{
+				if (moves[i].sourceX == scripted.sourceX && moves[i].sourceY == scripted.sourceY &&
+					moves[i].targetX == scripted.targetX && moves[i].targetY == scripted.targetY)
+					return scripted;
+			}
+		}
+		// the scripted swap is not valid on this board, play the first one that is
+		return moves[0];
+	}
+	case Policy::Random:
+	default:
+		return moves[randomGenerator.NextBounded((uint32_t)moves.size())];
+	}
+}
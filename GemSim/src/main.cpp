@@ -0,0 +1,144 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "GemColor.h"
+#include "Simulator.h"
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "usage: GemSim [options]" << std::endl
+			<< "  --games N          amount of games to play (1000)" << std::endl
+			<< "  --moves N          moves per game (100)" << std::endl
+			<< "  --threads N        worker threads, 0 for all cores (0)" << std::endl
+			<< "  --policy NAME      random, greedy or scripted (random)" << std::endl
+			<< "  --script FILE      swaps for the scripted policy, one \"sx sy tx ty\" per line" << std::endl
+			<< "  --columns N        board width (8)" << std::endl
+			<< "  --rows N           board height (8)" << std::endl
+			<< "  --colors N         gem colors in play, 1 to " << (int)GemColor::COUNT << " (" << (int)GemColor::COUNT << ")" << std::endl
+			<< "  --seed N           base seed (1)" << std::endl;
+	}
+
+	/*! \brief Reads the swaps of a script file
+	*
+	*	\param path The file to read
+	*	\param script Receives the swaps, source and target are ordered like the moves of BoardModel
+	*	\return false if the file could not be read
+	*/
+	bool LoadScript(const std::string& path, std::vector<BoardModel::Move>& script)
+	{
+		std::ifstream file(path.c_str());
+		if (file.is_open() == false)
+			return false;
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			int sourceX, sourceY, targetX, targetY;
+			if (!(stream >> sourceX >> sourceY >> targetX >> targetY))
+				continue;
+
+			// the target is always right of or below the source
+			if (targetX < sourceX || targetY < sourceY)
+			{
+				std::swap(sourceX, targetX);
+				std::swap(sourceY, targetY);
+			}
+
+			BoardModel::Move move = { (uint16_t)sourceX, (uint16_t)sourceY, (uint16_t)targetX, (uint16_t)targetY };
+			script.push_back(move);
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	SimulationSettings settings;
+	std::string scriptPath;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string option = argv[i];
+
+		if (option == "--help" || option == "-h")
+		{
+			PrintUsage();
+			return 0;
+		}
+
+		// every other option takes a value
+		if (i + 1 >= argc)
+		{
+			std::cerr << "missing value for " << option << std::endl;
+			PrintUsage();
+			return 1;
+		}
+		const char* value = argv[++i];
+
+		if (option == "--games")
+			settings.games = std::strtoull(value, nullptr, 10);
+		else if (option == "--moves")
+			settings.movesPerGame = (uint32_t)std::strtoul(value, nullptr, 10);
+		else if (option == "--threads")
+			settings.threads = (uint32_t)std::strtoul(value, nullptr, 10);
+		else if (option == "--columns")
+			settings.columns = (uint16_t)std::atoi(value);
+		else if (option == "--rows")
+			settings.rows = (uint16_t)std::atoi(value);
+		else if (option == "--colors")
+			settings.colors = (uint8_t)std::atoi(value);
+		else if (option == "--seed")
+			settings.seed = std::strtoull(value, nullptr, 10);
+		else if (option == "--script")
+			scriptPath = value;
+		else if (option == "--policy")
+		{
+			if (std::strcmp(value, "random") == 0)
+				settings.policy = Policy::Random;
+			else if (std::strcmp(value, "greedy") == 0)
+				settings.policy = Policy::Greedy;
+			else if (std::strcmp(value, "scripted") == 0)
+				settings.policy = Policy::Scripted;
+			else
+			{
+				std::cerr << "unknown policy " << value << std::endl;
+				return 1;
+			}
+		}
+		else
+		{
+			std::cerr << "unknown option " << option << std::endl;
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (settings.columns < 3 && settings.rows < 3)
+	{
+		std::cerr << "the board needs at least three columns or three rows" << std::endl;
+		return 1;
+	}
+
+	if (settings.policy == Policy::Scripted)
+	{
+		if (scriptPath.empty() || LoadScript(scriptPath, settings.script) == false)
+		{
+			std::cerr << "the scripted policy needs a readable --script file" << std::endl;
+			return 1;
+		}
+	}
+
+	Simulator simulator(settings);
+	SimulationReport report;
+	simulator.Run(report);
+	report.Print(std::cout);
+
+	return 0;
+}